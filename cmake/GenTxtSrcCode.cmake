@@ -0,0 +1,154 @@
+# GenTxtSrcCode.cmake
+#
+# Adds the text files of a target as generated code, each input file gets a build rule of its own.
+#
+#   gentxt_add_resources(<target> FILES <file>...
+#                        [OUTPUT_DIR <dir>]
+#                        [OUTPUT_TYPE <c|cpp|o|S>]
+#                        [NAMESPACE <name>]
+#                        [OPTIONS <argument>...])
+#
+# FILES        The input files, relative to the current source directory or absolute. Their names without
+#              extension have to be unique, they name the generated files.
+# OUTPUT_DIR   Directory of the generated files, ${CMAKE_CURRENT_BINARY_DIR}/gentxt/<target> by default. It is
+#              added to the include directories of the target.
+# OUTPUT_TYPE  c, cpp (default), o for ELF object files or S for assembler files, which need the ASM language.
+# NAMESPACE    Namespace of the variables for cpp.
+# OPTIONS      Further arguments of GenTxtSrcCode, e.g. --arraydefinitions or --blob.
+#
+# The directories and the output type are given on the command line, so they win over the @global options of the
+# input files and the generated paths are known here. Every input file has a rule of its own, so Ninja and make -j
+# generate them in parallel. The rule writes a depfile and touches a stamp file, the generated files are byproducts:
+# GenTxtSrcCode only replaces the files whose content changed, so the rule runs again only when the input file or the
+# program changed, and the sources that include an unchanged header are not compiled again. The sidecar files of
+# EMBED variables, of S output and of the variable cache are byproducts as well. They are named after the @variable
+# lines of the input file, which is read at configure time. An input that can have sidecars configures again when it
+# changes, one of S output, with an EMBED variable or the cache option. A few more files than written can be
+# declared, e.g. the sidecar of an S variable that points into another one.
+#
+# GenTxtSrcCode reads the input files relative to its project folder, GENTXT_PROJECT_DIR. The program is the target
+# GenTxtSrcCode if it exists, GENTXT_EXECUTABLE otherwise.
+
+if(POLICY CMP0116)
+    # the paths of the depfiles are relative to the build directory under Ninja as well
+    cmake_policy(SET CMP0116 NEW)
+endif()
+
+set(GENTXT_PROJECT_DIR "${CMAKE_CURRENT_LIST_DIR}/.." CACHE PATH "Project folder of GenTxtSrcCode, the input files are read relative to it")
+
+function(gentxt_add_resources target)
+    cmake_parse_arguments(GENTXT "" "OUTPUT_DIR;OUTPUT_TYPE;NAMESPACE" "FILES;OPTIONS" ${ARGN})
+
+    if(NOT GENTXT_FILES)
+        message(FATAL_ERROR "gentxt_add_resources(${target}): no FILES given")
+    endif()
+    if(NOT GENTXT_OUTPUT_DIR)
+        set(GENTXT_OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/gentxt/${target}")
+    endif()
+    if(NOT GENTXT_OUTPUT_TYPE)
+        set(GENTXT_OUTPUT_TYPE "cpp")
+    endif()
+    if(NOT GENTXT_OUTPUT_TYPE MATCHES "^(c|cpp|o|S)$")
+        message(FATAL_ERROR "gentxt_add_resources(${target}): OUTPUT_TYPE has to be c, cpp, o or S, given: ${GENTXT_OUTPUT_TYPE}")
+    endif()
+
+    if(TARGET GenTxtSrcCode)
+        set(generator "$<TARGET_FILE:GenTxtSrcCode>")
+        set(generatorDependency GenTxtSrcCode)
+    else()
+        find_program(GENTXT_EXECUTABLE GenTxtSrcCode)
+        if(NOT GENTXT_EXECUTABLE)
+            message(FATAL_ERROR "gentxt_add_resources(${target}): GenTxtSrcCode not found, set GENTXT_EXECUTABLE")
+        endif()
+        set(generator "${GENTXT_EXECUTABLE}")
+        set(generatorDependency "${GENTXT_EXECUTABLE}")
+    endif()
+
+    set(arguments -C -H "${GENTXT_OUTPUT_DIR}" -S "${GENTXT_OUTPUT_DIR}" -t "${GENTXT_OUTPUT_TYPE}")
+    if(GENTXT_NAMESPACE)
+        list(APPEND arguments -n "${GENTXT_NAMESPACE}")
+    endif()
+    list(APPEND arguments ${GENTXT_OPTIONS})
+
+    file(MAKE_DIRECTORY "${GENTXT_OUTPUT_DIR}")
+    set(names "")
+    foreach(input IN LISTS GENTXT_FILES)
+        get_filename_component(inputPath "${input}" ABSOLUTE BASE_DIR "${CMAKE_CURRENT_SOURCE_DIR}")
+        get_filename_component(name "${inputPath}" NAME_WE)
+
+        # two inputs with the same name would write the same files from parallel rules
+        if(name IN_LIST names)
+            message(FATAL_ERROR "gentxt_add_resources(${target}): more than one input file is named ${name}")
+        endif()
+        list(APPEND names "${name}")
+
+        set(header "${GENTXT_OUTPUT_DIR}/${name}.h")
+        set(source "${GENTXT_OUTPUT_DIR}/${name}.${GENTXT_OUTPUT_TYPE}")
+        set(depfile "${GENTXT_OUTPUT_DIR}/${name}.d")
+        set(stamp "${GENTXT_OUTPUT_DIR}/${name}.stamp")
+        file(RELATIVE_PATH projectInput "${GENTXT_PROJECT_DIR}" "${inputPath}")
+
+        # the names of the sidecar files, a variable without varname is named after the file
+        set(sidecars "")
+        set(embedLines FALSE)
+        file(STRINGS "${inputPath}" variableLines REGEX "^@variable")
+        foreach(line IN LISTS variableLines)
+            set(varname "${name}")
+            if(line MATCHES "\"varname\"[ \t]*:[ \t]*\"([A-Za-z0-9_]+)\"")
+                set(varname "${CMAKE_MATCH_1}")
+            endif()
+            string(TOUPPER "${line}" upperLine)
+            set(embed FALSE)
+            if(NOT GENTXT_OUTPUT_TYPE STREQUAL "o" AND upperLine MATCHES "\"SEQ\"[ \t]*:[ \t]*\"EMBED\"")
+                set(embed TRUE)
+                set(embedLines TRUE)
+            endif()
+            if(GENTXT_OUTPUT_TYPE STREQUAL "S" OR embed)
+                list(APPEND sidecars "${GENTXT_OUTPUT_DIR}/${name}_${varname}.bin")
+            endif()
+        endforeach()
+        if(GENTXT_OUTPUT_TYPE STREQUAL "S")
+            # the blob, or the whole file if it has no variables
+            list(APPEND sidecars "${GENTXT_OUTPUT_DIR}/${name}_blob.bin")
+            if(NOT variableLines)
+                list(APPEND sidecars "${GENTXT_OUTPUT_DIR}/${name}_${name}.bin")
+            endif()
+        elseif(NOT GENTXT_OUTPUT_TYPE STREQUAL "o")
+            file(STRINGS "${inputPath}" cacheLines REGEX "^@global.*\"cache\"[ \t]*:[ \t]*true")
+            if(cacheLines OR "-c" IN_LIST GENTXT_OPTIONS OR "--cache" IN_LIST GENTXT_OPTIONS)
+                list(APPEND sidecars "${source}.cache")
+            endif()
+        endif()
+
+        # the sidecars follow from the content only for S output, EMBED variables and the cache option, only then
+        # a change of the input configures again, other inputs are just generated again
+        if(GENTXT_OUTPUT_TYPE STREQUAL "S" OR embedLines OR cacheLines)
+            set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${inputPath}")
+        endif()
+
+        # Makefile generators know depfiles since CMake 3.20
+        set(depfileArguments "")
+        if(CMAKE_GENERATOR MATCHES "Ninja" OR CMAKE_VERSION VERSION_GREATER_EQUAL 3.20)
+            set(depfileArguments DEPFILE "${depfile}")
+        endif()
+
+        add_custom_command(
+            OUTPUT "${stamp}"
+            BYPRODUCTS "${header}" "${source}" ${sidecars}
+            COMMAND "${generator}" ${arguments} --depfile "${depfile}" --deptarget "${stamp}" "${projectInput}"
+            COMMAND "${CMAKE_COMMAND}" -E touch "${stamp}"
+            MAIN_DEPENDENCY "${inputPath}"
+            DEPENDS ${generatorDependency}
+            ${depfileArguments}
+            WORKING_DIRECTORY "${GENTXT_OUTPUT_DIR}"
+            COMMENT "Generating ${name}.h and ${name}.${GENTXT_OUTPUT_TYPE} from ${input}"
+            VERBATIM)
+
+        if(GENTXT_OUTPUT_TYPE STREQUAL "o")
+            set_source_files_properties("${source}" PROPERTIES EXTERNAL_OBJECT TRUE GENERATED TRUE)
+        endif()
+        target_sources(${target} PRIVATE "${stamp}" "${header}" "${source}")
+    endforeach()
+
+    target_include_directories(${target} PRIVATE "${GENTXT_OUTPUT_DIR}")
+endfunction()
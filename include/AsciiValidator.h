@@ -0,0 +1,55 @@
+/**
+ * @file AsciiValidator.h
+ * @brief Contains functions that check the content of a variable for non ASCII characters before it is converted.
+ */
+
+#ifndef ASCIIVALIDATOR_H
+#define ASCIIVALIDATOR_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include <ByteSource.h>
+
+/**
+ * @struct AsciiError
+ * @brief Position of a non ASCII character in the input file.
+ */
+struct AsciiError
+{
+    int line;           /**< Line in the input file */
+    std::size_t column; /**< Column in the line, starting at 1 */
+    unsigned char value; /**< The non ASCII character */
+};
+
+/**
+ * @brief Finds the first non ASCII character, 16 or 32 characters at a time if the CPU supports it.
+ *
+ * @param data The characters to check.
+ * @param length Number of characters.
+ * @return Offset of the first non ASCII character, length if there is none.
+ */
+std::size_t findNonAscii(const char *data, const std::size_t length);
+
+/**
+ * @brief Checks a whole content and collects every non ASCII character.
+ *
+ * The content is read once at full speed. Lines and columns are only counted in a second pass if an error was found.
+ *
+ * @param source ByteSource with the content, it is rewound after the check.
+ * @param firstLine Line of the input file the content starts in.
+ * @return All errors in the order of the content, empty if the content is ASCII only.
+ */
+std::vector<AsciiError> validateAscii(ByteSource &source, const int firstLine);
+
+/**
+ * @brief Formats an error the way it is logged.
+ *
+ * @param error The error.
+ * @param inputFile The name of the input file.
+ * @return Text of the error, without colors.
+ */
+std::string describeAsciiError(const AsciiError &error, const std::string &inputFile);
+
+#endif // ASCIIVALIDATOR_H
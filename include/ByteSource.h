@@ -0,0 +1,148 @@
+/**
+ * @file ByteSource.h
+ * @brief Contains the ByteSource classes that hand the content of a variable to the converters in chunks.
+ */
+
+#ifndef BYTESOURCE_H
+#define BYTESOURCE_H
+
+#include <string>
+#include <fstream>
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Number of characters a converter reads from a ByteSource at once.
+ */
+constexpr std::size_t SOURCE_CHUNK_SIZE = 64 * 1024;
+
+/**
+ * @class ByteSource
+ * @brief Base class for a range of bytes that is read front to back in chunks.
+ *
+ * The size of the range is known in advance, so converters know which byte is the last one
+ * without holding the whole content in memory.
+ */
+class ByteSource
+{
+public:
+    virtual ~ByteSource();
+
+    /**
+     * @brief Returns the number of bytes in the range.
+     */
+    virtual std::size_t size() const = 0;
+
+    /**
+     * @brief Reads the next chunk of the range.
+     *
+     * @param buffer Buffer the bytes are copied to.
+     * @param length Size of the buffer.
+     * @return Number of bytes read, 0 at the end of the range.
+     */
+    virtual std::size_t read(char *buffer, const std::size_t length) = 0;
+
+    /**
+     * @brief Starts reading from the beginning of the range again.
+     */
+    virtual void rewind() = 0;
+};
+
+/**
+ * @class StringSource
+ * @brief ByteSource over a string that is already in memory.
+ */
+class StringSource : public ByteSource
+{
+public:
+    /**
+     * @brief Constructs a StringSource over the first length characters of text.
+     *
+     * @param text The string to read, it has to live as long as the source.
+     * @param length Number of characters of the range.
+     */
+    StringSource(const std::string &text, const std::size_t length);
+    explicit StringSource(const std::string &text);
+
+    std::size_t size() const override;
+    std::size_t read(char *buffer, const std::size_t length) override;
+    void rewind() override;
+
+private:
+    const std::string &text; /**< The string that is read */
+    std::size_t length;      /**< Size of the range */
+    std::size_t position = 0; /**< Next character to read */
+};
+
+/**
+ * @class FileRangeSource
+ * @brief ByteSource over a part of a file, only one chunk of it is in memory at a time.
+ *
+ * The file is only open while the range is read: it is opened by the first read and closed at the end of the range
+ * and by rewind(), so any number of sources can wait to be read without running out of file handles.
+ */
+class FileRangeSource : public ByteSource
+{
+public:
+    /**
+     * @brief Remembers the range, the file is not opened yet.
+     *
+     * @param filePath Path to the file.
+     * @param offset Stream position where the range starts.
+     * @param length Number of characters of the range.
+     */
+    FileRangeSource(const std::string &filePath, const std::streamoff &offset, const std::size_t length);
+
+    std::size_t size() const override;
+
+    /**
+     * @copydoc ByteSource::read
+     * @throws std::runtime_error If the file can not be opened.
+     */
+    std::size_t read(char *buffer, const std::size_t length) override;
+    void rewind() override;
+
+private:
+    std::string filePath;     /**< Path to the file */
+    std::ifstream file;       /**< The file while the range is read */
+    std::streamoff offset;    /**< Stream position where the range starts */
+    std::size_t length;       /**< Size of the range */
+    std::size_t position = 0; /**< Number of characters already read */
+};
+
+/**
+ * @class ConcatSource
+ * @brief ByteSource over several sources, read one after the other as one range.
+ */
+class ConcatSource : public ByteSource
+{
+public:
+    /**
+     * @brief Takes the sources in the order they are read.
+     *
+     * @param parts The sources, their sizes have to stay the same.
+     */
+    explicit ConcatSource(std::vector<std::unique_ptr<ByteSource>> parts);
+
+    std::size_t size() const override;
+    std::size_t read(char *buffer, const std::size_t length) override;
+    void rewind() override;
+
+private:
+    std::vector<std::unique_ptr<ByteSource>> parts; /**< The sources */
+    std::size_t length = 0;                         /**< Sum of the sizes of the sources */
+    std::size_t current = 0;                        /**< Index of the source that is read */
+};
+
+/**
+ * @brief Copies a source unchanged into a binary file, in chunks.
+ *
+ * @param source The source, it is read from the beginning.
+ * @param filePath Path of the file, an existing file is only replaced if its content differs.
+ * @return True if the file was written, false if it already had the content.
+ * @throws std::runtime_error If the file can not be opened.
+ */
+bool copyToFile(ByteSource &source, const std::string &filePath);
+
+#endif // BYTESOURCE_H
@@ -0,0 +1,63 @@
+/**
+ * @file CTextToAutoSeq.h
+ * @brief Contains the CTextToAutoSeq class for converting text to the shortest string literal.
+ */
+
+#ifndef CTEXTTOAUTOSEQ_H
+#define CTEXTTOAUTOSEQ_H
+
+#include <CTextToCPP.h>
+
+/**
+ * @class CTextToAutoSeq
+ * @brief A class that converts text to the shortest valid string literal.
+ *
+ * This class inherits from the CTextToCPP class. Printable characters are written as they are, only '"' and '\\'
+ * and the control characters are escaped. A control character gets its named escape sequence (\\n, \\t, ...) if it
+ * has one, and the octal escape sequence with the fewest digits otherwise. Where the next character is an octal
+ * digit, the octal escape sequence is written with all three digits, so the digit does not become a part of it.
+ * A '?' behind another '?' is escaped, so no trigraph can come up.
+ */
+class CTextToAutoSeq : public CTextToCPP
+{
+public:
+    /**
+     * @brief Constructs a CTextToAutoSeq object with the specified variable and parameter.
+     * @param variable The VariableStruct object with the infos about the variable parameters
+     * @param parameter The ParamStruct object with the infos of the @global tags from inputfile.
+     */
+    CTextToAutoSeq(const VariableStruct &variable, const ParamStruct &parameter);
+
+    /**
+     * @brief Destroys the CTextToAutoSeq object.
+     */
+    ~CTextToAutoSeq();
+
+private:
+    /**
+     * @brief Converts the input string to the shortest string literal text and writes it as wrapped lines.
+     *
+     * Words end behind each space and the escape sequences of new line characters are units of their own,
+     * like for ESC.
+     *
+     * @param source ByteSource with the content, read in chunks.
+     * @param sink The sink the wrapped lines are written to.
+     * @param quotes Quote around each line.
+     * @param offset Position of the first byte of source in the content.
+     * @param total Size of the whole content.
+     */
+    void encode(ByteSource &source, OutputSink &sink, const std::string &quotes,
+                const std::size_t offset, const std::size_t total) override;
+
+    /**
+     * @brief Converts the content and hands it to the emitter.
+     *
+     * A character whose escape sequence depends on the next one is held back until the next chunk is read.
+     *
+     * @tparam Emitter The LineEmitter for the new line mode of the variable.
+     */
+    template <typename Emitter>
+    void encodeLines(ByteSource &source, Emitter &emitter);
+};
+
+#endif // CTEXTTOAUTOSEQ_H
@@ -9,7 +9,13 @@
 #include <string>
 #include <map>
 #include <Parameter.h>
+#include <LineEmitter.h>
+#include <ByteSource.h>
+#include <OutputSink.h>
+#include <AsciiValidator.h>
+#include <memory>
 #include <vector>
+#include <cstdint>
 struct Node
 {
     std::string data; // Elements
@@ -22,29 +28,46 @@ struct Node
  *
  * This class provides the base functionality for converting text to C++ code and managing data.
  * It includes functions for checking ASCII characters, handling new line characters, adding elements to a linked list,
- * sorting elements, clearing the linked list, generating declaration and implementation texts, and inserting line breaks in the text.
+ * sorting elements, clearing the linked list, generating declaration and implementation texts, and writing the converted text as wrapped lines.
  * It is intended to be inherited by derived classes that implement specific text-to-C++ conversion functionality.
  */
 class CTextToCPP
 {
 protected:
-    /**
-     * @brief Checks if the input character is an ASCII character and raises an error if it's not.
-     *
-     * @param input The input character to check.
-     * @param line The line number of the variable in the input file.
-     * @param pos The position of the character in the variable-part string.
-     * @param inputFile The name of the input file.
-     */
-    void checkASCII(const unsigned char &input, const int &line, const unsigned int &pos, const std::string &inputFile);
-
     /**
      * @brief Checks and handles the presence of new line characters in the input string.
 
     * @param input The input string to check and modify.
-    * @param nl The new line character depending on the operating system type.
+    * @param nl The new line mode of the variable.
     */
-    void checkNewLine(std::string &input, const std::string &nl);
+    void checkNewLine(std::string &input, const NewLineMode nl);
+
+    /**
+     * @brief Runs an encode kernel with the LineEmitter for the new line mode of the variable.
+     *
+     * The mode is switched on once per call, the kernel is a generic lambda that is instantiated for every
+     * LineEmitter<Mode>, so the unit loop of each (seq, nl) pair is compiled without any mode checks.
+     *
+     * @param sink The sink the wrapped lines are written to.
+     * @param quotes Quote around each line.
+     * @param kernel Callable that gets the emitter and hands the converted units to it.
+     */
+    template <typename Kernel>
+    void withLineEmitter(OutputSink &sink, const std::string &quotes, Kernel kernel)
+    {
+        switch (newLineMode)
+        {
+        case NewLineMode::DOS:
+            runKernel<NewLineMode::DOS>(sink, quotes, kernel);
+            break;
+        case NewLineMode::MAC:
+            runKernel<NewLineMode::MAC>(sink, quotes, kernel);
+            break;
+        default:
+            runKernel<NewLineMode::UNIX>(sink, quotes, kernel);
+            break;
+        }
+    }
 
 public:
     /**
@@ -87,10 +110,12 @@ public:
      * This function generates the declaration text for the input file.
      * It constructs the declaration code based on the variable name, type, and other options.
      * If a doxygen comment is provided for the variable, it is included in the declaration.
+     * It is followed by the NAME_size constant with the length of the content if hasSizeConstant() is true.
      *
+     * @param external Declares the variable extern, for a header of an object file that defines it.
      * @return Declaration text.
      */
-    std::string writeDeclaration();
+    std::string writeDeclaration(const bool external = false);
     /**
      * @brief Function to generate the source text for the input file.
      *
@@ -98,6 +123,125 @@ public:
      */
     std::string writeImplementation();
 
+    /**
+     * @brief Checks the whole content of the variable for non ASCII characters.
+     *
+     * The converters do not check the characters themselves, so this has to be called before writeImplementation().
+     *
+     * @return Every non ASCII character with its line and column in the input file, empty if there is none.
+     */
+    std::vector<AsciiError> checkContent();
+
+    /**
+     * @brief Function to write the source text for the input file to a sink.
+     *
+     * The content is read in chunks and every finished line goes straight to the sink, so the memory needed
+     * does not depend on the size of the variable if its content is a range of the input file.
+     *
+     * @param sink The sink the source text is written to.
+     */
+    void writeImplementation(OutputSink &sink);
+
+    /**
+     * @brief Returns the path of the binary file an EMBED variable is written to for #embed.
+     *
+     * The file is named like the sidecar files of the assembler output, so the variables of different input files
+     * can have the same name.
+     *
+     * @return The file INPUT_NAME.bin in the source directory.
+     */
+    std::string embedFilePath() const;
+
+    /**
+     * @brief Returns if the declaration defines NAME_size as constant.
+     *
+     * @return True for packed RAWHEX32/RAWHEX64 arrays and for every variable with array definitions.
+     */
+    bool hasSizeConstant() const;
+
+    /**
+     * @brief Returns the definition of the NAME_size constant for the header.
+     *
+     * @param name Name of the variable.
+     * @param size Number of content bytes.
+     * @return For example "static const size_t NAME_size = 10;\n".
+     */
+    static std::string sizeConstant(const std::string &name, const std::size_t size);
+
+    /**
+     * @brief Opens the content of the variable without its trailing new line.
+     *
+     * @return Source over the content, from memory or from the range in the input file.
+     */
+    std::unique_ptr<ByteSource> openContent();
+
+    /**
+     * @brief Returns the exact number of characters writeImplementation() writes, to allocate the buffer once.
+     *
+     * The fragments of HEX, OCT and the RAWHEX seqs have a fixed width, their size follows from the number of
+     * bytes and the positions of the new lines. ESC, AUTO and RAW are converted into a CountingSink that keeps
+     * nothing but the count.
+     *
+     * @return Size of the source text of the variable.
+     */
+    std::size_t implementationSize();
+
+    /**
+     * @brief Lets other variables point into the content of this string variable.
+     *
+     * The converted text becomes the static array NAME_content and the variable a pointer to it.
+     */
+    void shareContent();
+
+    /**
+     * @brief Lets the variables of other source files point into the content of this string variable.
+     *
+     * Like shareContent(), but NAME_content is defined with external linkage.
+     */
+    void exportContent();
+
+    /**
+     * @brief Returns the definition of this string variable as pointer into the content of another one.
+     *
+     * @param targetName Name of the variable whose content was shared with shareContent().
+     * @param offset Position of the content of this variable in the content of the other one.
+     * @return For example "const char *const NAME = OTHER_content + 4;\n".
+     */
+    std::string writeAliasDefinition(const std::string &targetName, const std::size_t offset) const;
+
+    /**
+     * @brief Returns the key of the converted variable in the VariableCache.
+     *
+     * It hashes everything writeImplementation() depends on: the content, the variable options, the global options
+     * that change the code and if the content is shared or exported. The content is read once.
+     *
+     * @return The key.
+     */
+    std::uint64_t implementationKey();
+
+    /**
+     * @brief Writes the converted content alone, the lines that go between the braces of the definition.
+     *
+     * @param sink The sink the converted lines are written to.
+     */
+    void writeContent(OutputSink &sink);
+
+    /**
+     * @brief Writes the comment with the original text if the variable has addtextsegment.
+     *
+     * @param sink The sink the comment is written to.
+     */
+    void writeTextSegment(OutputSink &sink);
+
+    /**
+     * @brief Returns the header code of a variable whose content is packed into the blob of its file.
+     *
+     * @param blobName Name of the char array with the contents of all variables of the file.
+     * @param offset Position of the content in the blob.
+     * @return An inline accessor NAME() that returns the content and the NAME_size constant.
+     */
+    std::string writeBlobAccessor(const std::string &blobName, const std::size_t offset);
+
 private:
     /**
      * @brief Contains the @global options.
@@ -107,33 +251,148 @@ private:
      * @brief Contains the @variable parameters.
      */
     struct VariableStruct variable;
+    /**
+     * @brief The seq of the variable, parsed once.
+     */
+    SeqType seqType;
+    /**
+     * @brief The nl of the variable, parsed once.
+     */
+    NewLineMode newLineMode;
+    /**
+     * @brief Other variables point into the content, it is defined as NAME_content.
+     */
+    bool sharedContent = false;
+    /**
+     * @brief Other source files point into the content, NAME_content is not static.
+     */
+    bool exportedContent = false;
+
+    /**
+     * @brief Returns the type and name of the variable as they start its declaration and definition.
+     *
+     * The string seqs define a char array instead of a pointer with array definitions, so no relocation is needed.
+     *
+     * @return For example "const char *const NAME", "const char NAME[]" or "const uint64_t NAME[]".
+     */
+    std::string writeDefinitionHead() const;
+
+    /**
+     * @brief Returns the name of the binary file of an EMBED variable, as the #embed line names it.
+     *
+     * @return INPUT_NAME.bin, where INPUT is the name of the input file without extension.
+     */
+    std::string embedFileName() const;
+
+    /**
+     * @brief Returns the code in front of the converted content, the opening of the definition.
+     *
+     * @return For example "const char *const NAME = {\n", with the #embed line for EMBED.
+     */
+    std::string writeDefinitionOpening() const;
+
+    /**
+     * @brief Returns the code behind the converted content, the end of the definition.
+     *
+     * @return "};\n", with the #endif for EMBED and the pointer to NAME_content for a shared content.
+     */
+    std::string writeDefinitionClosing() const;
 
     /**
-     * @brief Pure virtual function to convert the input string to the desired format.
+     * @brief Returns the initializer of an empty content.
+     *
+     * @return "0\n" for the array seqs, "\"\"\n" for a string seq with array definitions, empty otherwise.
+     */
+    std::string writeEmptyContent() const;
+
+    /**
+     * @brief Returns the start of the comment with the original text, the text and the end of the comment follow it.
+     */
+    std::string writeTextSegmentHead() const;
+
+    /**
+     * @brief Returns the number of characters writeContent() writes for a seq with fragments of fixed width.
+     *
+     * The content is only searched for the new lines that end a line, every part between them is wrapped
+     * after the same number of fragments.
+     *
+     * @param source The content.
+     * @param quoteSize Size of the quote around each line.
+     * @return Size of the converted lines.
+     */
+    std::size_t fixedWidthContentSize(ByteSource &source, const std::size_t quoteSize) const;
+
+    /**
+     * @brief Returns the doxygen comment of the variable for the header.
+     *
+     * @return The comment with the line of the variable if addtextpos is set, empty without doxygen text.
+     */
+    std::string writeDoxygen() const;
+
+    /**
+     * @brief Pure virtual function to convert the content and write it as wrapped lines in one pass.
      *
      * This function is a pure virtual function that needs to be implemented by derived classes.
-     * It converts the input string to the desired format (escape sequence, hex sequence, octal sequence, etc.),
-     * taking into account the variable line number, input file name, and new line character.
+     * It reads the content from the source in chunks, converts it to the desired format and hands the converted
+     * text to a LineEmitter from withLineEmitter() in units that must not be split across lines,
+     * so no second pass over the converted text is needed.
      *
-     * @param inputString String that is being modified.
-     * @param varLine Integer with the line Number of the variable
-     * @param inputFile String with the Name of the inputFile
-     * @param  nl New line character depending on os type
+     * @param source ByteSource with the content, the trailing new line is already removed.
+     * @param sink The sink the wrapped lines are written to.
+     * @param quotes Quote around each line.
+     * @param offset Position of the first byte of source in the content, source can be one block of it.
+     * @param total Size of the whole content.
+     */
+    virtual void encode(ByteSource &source, OutputSink &sink, const std::string &quotes,
+                        const std::size_t offset, const std::size_t total) = 0;
+
+    /**
+     * @brief Runs an encode kernel with a LineEmitter<Mode> and writes the last line.
+     */
+    template <NewLineMode Mode, typename Kernel>
+    void runKernel(OutputSink &sink, const std::string &quotes, Kernel &kernel)
+    {
+        LineEmitter<Mode> emitter(sink, parameter.signPerLine, quotes);
+        kernel(emitter);
+        emitter.finish();
+    }
+
+    /**
+     * @brief Returns the width every character is converted to if all units have the same width.
+     *
+     * @return Width of one unit, 0 if the width depends on the content.
+     */
+    virtual std::size_t unitWidth() const;
+
+    /**
+     * @brief Converts a large content in blocks on the shared ThreadPool and writes the blocks in order.
+     *
+     * Every block starts at a position where the serial emitter starts a new line, so the converted blocks
+     * only have to be concatenated to be byte-identical to the serial output.
+     *
+     * @param source ByteSource with the content, the trailing new line is already removed.
+     * @param sink The sink the wrapped lines are written to.
+     * @param quotes Quote around each line.
+     */
+    void encodeParallel(ByteSource &source, OutputSink &sink, const std::string &quotes);
+
+    /**
+     * @brief Finds the first line start behind a forced line break (new line or DOS CR) at or after from.
      *
-     * @return The modified output string with the desired format.
+     * @param data Content that starts at the beginning of a line.
+     * @param from Position the break character has to be at or after.
+     * @return Position behind the break, std::string::npos if there is none.
      */
-    virtual std::string convert(std::string &inputString, const int &varLine, const std::string &inputFile, const std::string &nl) = 0;
+    std::size_t findLineBreak(const std::string &data, const std::size_t from) const;
 
     /**
-     * @brief Function to insert line breaks after certain amount of signs per line.
+     * @brief Finds the first position at or after from where the serial emitter starts a new line.
      *
-     * @param signPerLine Number of signs per line.
-     * @param text Text to be processed.
-     * @param  nl New line character depending on os type
-     * @param seq Type of text.
-     * @return The modified text with each line not longer than the given number of signs per line.
+     * @param data Content that starts at the beginning of a line.
+     * @param from Smallest position that may be returned.
+     * @return The position, std::string::npos if none can be determined without converting.
      */
-    std::vector<std::string> insertLineBreaks(const int &signPerLine, const std::string &text, const std::string &nl, const std::string &seq);
+    std::size_t findLineStart(const std::string &data, const std::size_t from) const;
 
     /**
      * @brief Represents project path.
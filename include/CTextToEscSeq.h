@@ -13,7 +13,7 @@
  * @brief A class that converts text to escape sequences.
  *
  * This class inherits from the CTextToCPP class and provides an implementation to convert text
- * to escape sequences. It overrides the convert function to perform the conversion.
+ * to escape sequences. It overrides the encode function to perform the conversion.
  */
 class CTextToEscSeq : public CTextToCPP
 {
@@ -28,19 +28,32 @@ public:
 
 private:
     /**
-     * @brief Converts the input string to escape sequences.
+     * @brief Converts the input string to escape sequences and writes it as wrapped lines.
      *
-     * This function converts the input string to escape sequences by iterating over each character
-     * in the string, checking for ASCII characters, and replacing them with their corresponding escape
-     * sequences. It also takes into account the variable line number, input file name, and new line character.
+     * Words end behind each space and the escape sequences of new line characters are units of their own,
+     * so a line is only broken between words.
+     * The chunks are scanned 16 or 32 bytes at a time (SSE2/AVX2, chosen at runtime from the CPU features, with a
+     * scalar fallback) for characters that need an escape sequence or end a word, the runs between them are
+     * handed to the emitter in one piece.
      *
-     * @param inputString String that is being modified.
-     * @param varLine Integer with the line Number of the variable
-     * @param inputFile String with the Name of the inputFile
-     * @param  nl New line character depending on os type
-     * @return Modified ouput string with escape sequences.
+     * @param source ByteSource with the content, read in chunks.
+     * @param sink The sink the wrapped lines are written to.
+     * @param quotes Quote around each line.
+     * @param offset Position of the first byte of source in the content.
+     * @param total Size of the whole content.
      */
-    std::string convert(std::string &inputString, const int &varLine, const std::string &inputFile, const std::string &nl) override;
+    void encode(ByteSource &source, OutputSink &sink, const std::string &quotes,
+                const std::size_t offset, const std::size_t total) override;
+
+    /**
+     * @brief Converts the content to escape sequences and hands them to the emitter.
+     *
+     * A word ends behind each space, new line characters are words of their own.
+     *
+     * @tparam Emitter The LineEmitter for the new line mode of the variable.
+     */
+    template <typename Emitter>
+    void encodeLines(ByteSource &source, Emitter &emitter);
 };
 
 #endif // CTEXTTOESCSEQ_H
\ No newline at end of file
@@ -13,7 +13,7 @@
  * @brief A class that converts text to octal sequences.
  *
  * This class inherits from the CTextToCPP class and provides an implementation to convert text
- * to octal sequences. It overrides the convert function to perform the conversion.
+ * to octal sequences. It overrides the encode function to perform the conversion.
  */
 class CTextToOctSeq : public CTextToCPP
 {
@@ -32,20 +32,31 @@ public:
 
 private:
     /**
-     * @brief Converts the input string to an octal sequence.
+     * @brief Converts the input string to an octal sequence and writes it as wrapped lines.
      *
-     * This function converts the input string to an octal sequence by iterating over each character
-     * in the string, checking for ASCII characters, and adding the corresponding octal representation
-     * to the output stream. It also takes into account the variable line number, input file name, and
-     * new line character.
+     * Every "\NNN" fragment is a unit of its own.
      *
-     * @param inputString String that is being modified.
-     * @param varLine Integer with the line Number of the variable
-     * @param inputFile String with the Name of the inputFile
-     * @param  nl New line character depending on os type
-     * @return Modified ouput string with escape sequences.
+     * @param source ByteSource with the content, read in chunks.
+     * @param sink The sink the wrapped lines are written to.
+     * @param quotes Quote around each line.
+     * @param offset Position of the first byte of source in the content.
+     * @param total Size of the whole content.
      */
-    std::string convert(std::string &inputString, const int &varLine, const std::string &inputFile, const std::string &nl) override;
+    void encode(ByteSource &source, OutputSink &sink, const std::string &quotes,
+                const std::size_t offset, const std::size_t total) override;
+
+    /**
+     * @brief Converts the content to "\NNN" fragments and hands each of them to the emitter as a unit.
+     *
+     * @tparam Emitter The LineEmitter for the new line mode of the variable.
+     */
+    template <typename Emitter>
+    void encodeLines(ByteSource &source, Emitter &emitter);
+
+    /**
+     * @brief Every character is converted to a fragment of the same width.
+     */
+    std::size_t unitWidth() const override;
 };
 
 #endif // CTEXTTOOCTSEQ_H
\ No newline at end of file
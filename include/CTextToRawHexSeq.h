@@ -12,7 +12,7 @@
  * @brief A class that converts text to raw hexadecimal sequences.
  *
  * This class inherits from the CTextToCPP class and provides an implementation to convert text
- * to raw hexadecimal sequences. It overrides the convert function to perform the conversion.
+ * to raw hexadecimal sequences. It overrides the encode function to perform the conversion.
  */
 class CTextToRawHexSeq : public CTextToCPP
 {
@@ -30,19 +30,49 @@ public:
 
 private:
     /**
-     * @brief Converts the input string to a raw hexadecimal sequence.
+     * @brief Converts the input string to a raw hexadecimal sequence and writes it as wrapped lines.
      *
-     * This function converts the input string to a raw hexadecimal sequence by iterating over each character
-     * in the string, checking for ASCII characters, and adding the corresponding hexadecimal representation to
-     * the output stream. It also takes into account the variable line number, input file name, and new line character.
+     * Every element is written as "0xNN," (the last one without comma) and is a unit of its own.
+     * RAWHEX32 and RAWHEX64 write one element per 4 or 8 bytes instead.
      *
-     * @param inputString String that is being modified.
-     * @param varLine Integer with the line Number of the variable
-     * @param inputFile String with the Name of the inputFile
-     * @param  nl New line character depending on os type
-     * @return Modified ouput string with escape sequences.
+     * @param source ByteSource with the content, read in chunks.
+     * @param sink The sink the wrapped lines are written to.
+     * @param quotes Quote around each line.
+     * @param offset Position of the first byte of source in the content.
+     * @param total Size of the whole content.
      */
-    std::string convert(std::string &inputString, const int &varLine, const std::string &inputFile, const std::string &nl) override;
+    void encode(ByteSource &source, OutputSink &sink, const std::string &quotes,
+                const std::size_t offset, const std::size_t total) override;
+
+    /**
+     * @brief Converts the content to "0xNN," elements and hands each of them to the emitter as a unit.
+     *
+     * @tparam Emitter The LineEmitter for the new line mode of the variable.
+     */
+    template <typename Emitter>
+    void encodeLines(ByteSource &source, Emitter &emitter, const std::size_t offset, const std::size_t total);
+
+    /**
+     * @brief Packs the content into little endian words and hands each "0x..." element to the emitter as a unit.
+     *
+     * The last word is padded with zero bytes. The elements do not end lines at new line characters,
+     * because a word holds several characters.
+     *
+     * @tparam WordSize Number of bytes in one element, 4 or 8.
+     * @tparam Emitter The LineEmitter for the new line mode of the variable.
+     */
+    template <std::size_t WordSize, typename Emitter>
+    void encodeWords(ByteSource &source, Emitter &emitter, const std::size_t total);
+
+    /**
+     * @brief Every character is converted to a fragment of the same width.
+     */
+    std::size_t unitWidth() const override;
+
+    /**
+     * @brief Number of content bytes in one array element, 1 for RAWHEX and EMBED.
+     */
+    const std::size_t wordSize;
 };
 
 #endif // CTEXTTORAWHEXSEQ_H
\ No newline at end of file
@@ -0,0 +1,70 @@
+/**
+ * @file CTextToRawSeq.h
+ * @brief Contains the CTextToRawSeq class for converting text to C++ raw string literals.
+ */
+
+#ifndef CTEXTTORAWSEQ_H
+#define CTEXTTORAWSEQ_H
+
+#include <CTextToCPP.h>
+
+/**
+ * @brief Maximum number of content bytes in one raw string literal, below the 16380 bytes MSVC accepts.
+ */
+constexpr std::size_t RAW_PIECE_SIZE = 16000;
+
+/**
+ * @class CTextToRawSeq
+ * @brief A class that converts text to C++ raw string literals.
+ *
+ * This class inherits from the CTextToCPP class. The content is written as it is into R"d(...)d" literals, so
+ * the generated source is about as big as the content and the compiler has no escape sequences to read.
+ * The delimiter d is the shortest one whose ")d\"" does not occur in the content. A literal holds at most
+ * RAW_PIECE_SIZE bytes, longer contents are split into adjacent literals. Carriage returns and the other control
+ * characters except tab and line feed do not survive the translation phases in a raw string, they are written
+ * as escape sequences in ordinary literals between the raw ones. Raw strings need C++11, they are not written
+ * for C output. The lines follow the content, signPerLine is not used.
+ */
+class CTextToRawSeq : public CTextToCPP
+{
+public:
+    /**
+     * @brief Constructs a CTextToRawSeq object with the specified variable and parameter.
+     * @param variable The VariableStruct object with the infos about the variable parameters
+     * @param parameter The ParamStruct object with the infos of the @global tags from inputfile.
+     */
+    CTextToRawSeq(const VariableStruct &variable, const ParamStruct &parameter);
+
+    /**
+     * @brief Destroys the CTextToRawSeq object.
+     */
+    ~CTextToRawSeq();
+
+    /**
+     * @brief Finds the shortest delimiter for raw string literals of the content.
+     *
+     * The content is read once, every ")d\"" with an identifier d of up to 16 characters is collected and
+     * the first of "", "a" to "z", "aa", ... that is not among them is returned.
+     *
+     * @param source ByteSource with the content, it is read to its end.
+     * @return The delimiter, without parentheses.
+     */
+    static std::string findDelimiter(ByteSource &source);
+
+private:
+    /**
+     * @brief Writes the content as raw string literals.
+     *
+     * The content is read twice, once for the delimiter and once for the literals.
+     *
+     * @param source ByteSource with the content, read in chunks.
+     * @param sink The sink the literals are written to.
+     * @param quotes Not used, the literals have their own quotes.
+     * @param offset Position of the first byte of source in the content.
+     * @param total Size of the whole content.
+     */
+    void encode(ByteSource &source, OutputSink &sink, const std::string &quotes,
+                const std::size_t offset, const std::size_t total) override;
+};
+
+#endif // CTEXTTORAWSEQ_H
@@ -0,0 +1,48 @@
+/**
+ * @file ContentDeduplicator.h
+ * @brief Contains functions that find variables whose content is equal to or a suffix of the content of another one.
+ */
+
+#ifndef CONTENTDEDUPLICATOR_H
+#define CONTENTDEDUPLICATOR_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include <ByteSource.h>
+
+/**
+ * @struct ContentAlias
+ * @brief Where the content of a variable is found in the content of another variable.
+ */
+struct ContentAlias
+{
+    std::size_t target; /**< Index of the variable that holds the content, the variable itself if it holds its own */
+    std::size_t offset; /**< Position of the content in the content of target, the content ends where it ends */
+};
+
+/**
+ * @brief Checks if a content ends with another one.
+ *
+ * Both sources are rewound, the bytes in front of the suffix are read and skipped.
+ *
+ * @param content The longer content.
+ * @param suffix The content it should end with.
+ * @return True if the last suffix.size() bytes of content are equal to suffix.
+ */
+bool endsWith(ByteSource &content, ByteSource &suffix);
+
+/**
+ * @brief Finds the variables that can use the content of another variable.
+ *
+ * Every content is read once for its size, a hash and its last bytes. The longest contents hold their own content,
+ * a shorter one that is equal to or a suffix of one of them gets it as target. Only candidates whose size, hash or
+ * last bytes fit are compared byte by byte, so different contents are not read again.
+ *
+ * @param sources One source per variable, nullptr for a variable that is left out. Empty contents are left out too.
+ * @return One ContentAlias per source, in the same order.
+ */
+std::vector<ContentAlias> findContentAliases(const std::vector<std::unique_ptr<ByteSource>> &sources);
+
+#endif // CONTENTDEDUPLICATOR_H
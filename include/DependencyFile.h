@@ -0,0 +1,31 @@
+/**
+ * @file DependencyFile.h
+ * @brief Contains the functions that write the generated files and their inputs as make rule for make and ninja.
+ */
+
+#ifndef DEPENDENCYFILE_H
+#define DEPENDENCYFILE_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Escapes a path for a make rule, a space, '#' and '$' would end or change the path otherwise.
+ *
+ * @param path The path.
+ * @return The escaped path.
+ */
+std::string escapeMakePath(const std::string &path);
+
+/**
+ * @brief Returns a make rule without recipe, the format gcc -MD writes and ninja reads as depfile.
+ *
+ * Every path is on a line of its own, the lines are continued with a backslash.
+ *
+ * @param targets The generated files.
+ * @param prerequisites The files they are generated from.
+ * @return The rule, ending with a new line.
+ */
+std::string writeMakeRule(const std::vector<std::string> &targets, const std::vector<std::string> &prerequisites);
+
+#endif // DEPENDENCYFILE_H
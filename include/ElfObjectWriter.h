@@ -0,0 +1,92 @@
+/**
+ * @file ElfObjectWriter.h
+ * @brief Contains the ElfObjectWriter class that writes variables as relocatable ELF64 object file.
+ */
+
+#ifndef ELFOBJECTWRITER_H
+#define ELFOBJECTWRITER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include <ByteSource.h>
+#include <OutputSink.h>
+
+/**
+ * @class ElfObjectWriter
+ * @brief Writes the contents of variables into a relocatable ELF64 object file that can be linked directly.
+ *
+ * The bytes of every variable are copied into .rodata as they are, nothing is converted to text and no compiler is
+ * needed. A string variable gets a trailing NUL and a pointer of the same name in .data.rel.ro that is relocated to its
+ * bytes, like "const char *const NAME". An array variable is a symbol in .rodata itself, like "const char NAME[]",
+ * a string array the same with the trailing NUL.
+ * The layout is computed from the sizes of the sources, so the contents are streamed to the sink in chunks.
+ * The object is written for the machine the generator is built for (x86-64 or AArch64, little endian).
+ */
+class ElfObjectWriter
+{
+public:
+    /**
+     * @brief Adds a string variable, a NUL terminated text and a pointer to it.
+     *
+     * @param symbol Name of the pointer symbol.
+     * @param content Source over the text, read when the object is written.
+     */
+    void addString(const std::string &symbol, std::unique_ptr<ByteSource> content);
+
+    /**
+     * @brief Adds a string variable as array, the NUL terminated text is the symbol itself and needs no relocation.
+     *
+     * @param symbol Name of the array symbol.
+     * @param content Source over the text, read when the object is written.
+     */
+    void addStringArray(const std::string &symbol, std::unique_ptr<ByteSource> content);
+
+    /**
+     * @brief Adds a string variable that points into the text of another string variable, which ends with its text.
+     *
+     * @param symbol Name of the pointer symbol.
+     * @param target Name of the string variable added with addString() that holds the text.
+     * @param offset Position of the text in the text of target.
+     */
+    void addStringAlias(const std::string &symbol, const std::string &target, const std::size_t offset);
+
+    /**
+     * @brief Adds an array variable, the bytes of the content without terminator.
+     *
+     * @param symbol Name of the array symbol.
+     * @param content Source over the bytes, read when the object is written.
+     * @param alignment The array starts at a multiple of it and is padded with zeros to a multiple of it,
+     * the element size of packed arrays.
+     */
+    void addArray(const std::string &symbol, std::unique_ptr<ByteSource> content, const std::size_t alignment = 1);
+
+    /**
+     * @brief Writes the object file.
+     *
+     * @param sink The sink the object file is written to, it has to be opened in binary mode.
+     * @return Size of the object file.
+     */
+    std::size_t write(OutputSink &sink);
+
+private:
+    /**
+     * @brief A variable of the object file.
+     */
+    struct Entry
+    {
+        std::string symbol;                  /**< Name of the symbol */
+        std::unique_ptr<ByteSource> content; /**< Bytes of the variable, a file range is only open while it is copied */
+        bool isString;                       /**< NUL terminated */
+        bool isPointer;                      /**< Accessed through a pointer in .data.rel.ro */
+        std::size_t alignment;               /**< Alignment and size granularity of an array */
+        std::string target;                  /**< String variable an alias points into, empty for the others */
+        std::size_t targetOffset;            /**< Position of the text of an alias in the text of target */
+    };
+
+    std::vector<Entry> entries; /**< Variables in the order they were added */
+};
+
+#endif // ELFOBJECTWRITER_H
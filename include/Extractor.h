@@ -20,10 +20,14 @@ std::map<std::string, std::string> parseJsonString(const std::string &jsonString
 /**
  * Extracts options and variables from an input string and populates the provided maps and vector.
  *
+ * The file is read line by line. Besides "content" every variable gets "ContentOffset", "ContentLength" and
+ * "ContentTail" (its last two characters), so the content can be read again from the file later.
+ *
  * @param inputFilePath The Path to file inputfile.
  * @param options The map to store extracted options (key-value pairs).
  * @param variables The vector of maps to store extracted variables (key-value pairs).
+ * @param keepContent If false, "content" stays empty and only the position of the content is stored.
  */
-void extractOptionsAndVariables(const std::string &inputFilePath, std::map<std::string, std::string> &options, std::vector<std::map<std::string, std::string>> &variables);
+void extractOptionsAndVariables(const std::string &inputFilePath, std::map<std::string, std::string> &options, std::vector<std::map<std::string, std::string>> &variables, const bool keepContent = true);
 
 #endif // EXTRACTOR_H
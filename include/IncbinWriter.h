@@ -0,0 +1,101 @@
+/**
+ * @file IncbinWriter.h
+ * @brief Contains the IncbinWriter class that writes a GNU assembler file including the contents as binary files.
+ */
+
+#ifndef INCBINWRITER_H
+#define INCBINWRITER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include <OutputSink.h>
+
+/**
+ * @class IncbinWriter
+ * @brief Writes a GNU assembler .S file that defines the variables with .incbin of binary sidecar files.
+ *
+ * The assembler copies the sidecar files into the object as they are, so no escaped literal has to be tokenized.
+ * A string variable is a NUL terminated text in .rodata and a pointer of the variable name to it, like
+ * "const char *const NAME". An array variable is the symbol of the bytes in .rodata, like "const char NAME[]",
+ * a string array the same with the trailing NUL.
+ * Every variable also gets NAME_size with the number of content bytes, a size_t.
+ */
+class IncbinWriter
+{
+public:
+    /**
+     * @brief Adds a string variable.
+     *
+     * @param symbol Name of the pointer symbol.
+     * @param binaryPath Path of the sidecar file with the content.
+     * @param size Number of bytes in the sidecar file.
+     */
+    void addString(const std::string &symbol, const std::string &binaryPath, const std::size_t size);
+
+    /**
+     * @brief Adds a string variable as array, the NUL terminated text is the symbol itself and needs no relocation.
+     *
+     * @param symbol Name of the array symbol.
+     * @param binaryPath Path of the sidecar file with the content.
+     * @param size Number of bytes in the sidecar file.
+     */
+    void addStringArray(const std::string &symbol, const std::string &binaryPath, const std::size_t size);
+
+    /**
+     * @brief Adds a string variable that points into the text of another string variable, which ends with its text.
+     *
+     * @param symbol Name of the pointer symbol.
+     * @param target Name of the string variable added with addString() that holds the text.
+     * @param offset Position of the text in the text of target.
+     * @param size Number of bytes of the text.
+     */
+    void addStringAlias(const std::string &symbol, const std::string &target, const std::size_t offset, const std::size_t size);
+
+    /**
+     * @brief Adds an array variable.
+     *
+     * @param symbol Name of the array symbol.
+     * @param binaryPath Path of the sidecar file with the content.
+     * @param size Number of bytes in the sidecar file.
+     * @param alignment The array starts at a multiple of it and is padded with zeros to a multiple of it,
+     * the element size of packed arrays.
+     */
+    void addArray(const std::string &symbol, const std::string &binaryPath, const std::size_t size, const std::size_t alignment = 1);
+
+    /**
+     * @brief Writes the assembler file.
+     *
+     * @param sink The sink the assembler file is written to.
+     */
+    void write(OutputSink &sink) const;
+
+    /**
+     * @brief Returns the declaration of the size symbol of a variable for the header.
+     *
+     * @param symbol Name of the variable.
+     * @return The extern declaration of NAME_size.
+     */
+    static std::string sizeDeclaration(const std::string &symbol);
+
+private:
+    /**
+     * @brief A variable of the assembler file.
+     */
+    struct Entry
+    {
+        std::string symbol;     /**< Name of the symbol */
+        std::string binaryPath; /**< Sidecar file with the content */
+        std::size_t size;       /**< Number of content bytes */
+        bool isString;          /**< NUL terminated */
+        bool isPointer;         /**< Accessed through a pointer in .data.rel.ro */
+        std::size_t alignment;  /**< Alignment and size granularity of an array */
+        std::string target;     /**< String variable an alias points into, empty for the others */
+        std::size_t offset;     /**< Position of the text of an alias in the text of target */
+    };
+
+    std::vector<Entry> entries; /**< Variables in the order they were added */
+};
+
+#endif // INCBINWRITER_H
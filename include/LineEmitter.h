@@ -0,0 +1,171 @@
+/**
+ * @file LineEmitter.h
+ * @brief Contains the LineEmitter class that writes converted text as wrapped source lines.
+ */
+
+#ifndef LINEEMITTER_H
+#define LINEEMITTER_H
+
+#include <string>
+#include <cstddef>
+
+#include <OutputSink.h>
+#include <Parameter.h>
+
+/**
+ * @class LineEmitter
+ * @brief Writes the converted text of a variable directly as wrapped lines of the source file.
+ *
+ * The converters hand over their output in units that must not be split (a "\xNN" fragment, a "0xNN," element
+ * or an ESC word with its trailing space). The emitter tracks the column of the current line and starts a new
+ * line before a unit that would exceed the signs per line. After the unit of a new line character of the
+ * input it ends the line according to the new line mode (UNIX = LF, MAC = CR, DOS = the unit after a CR).
+ * Every line is written to the OutputSink as quote + line + quote + " \\" + new line, so only the current line is buffered.
+ * The new line mode is a template parameter, so the rules are resolved at compile time for every unit.
+ *
+ * @tparam Mode New line mode of the variable.
+ */
+template <NewLineMode Mode>
+class LineEmitter
+{
+public:
+    /**
+     * @brief Constructs a LineEmitter that writes to the given output.
+     *
+     * @param output The sink the finished lines are written to.
+     * @param signPerLine Number of signs per line.
+     * @param quote Quote written around each line, empty for RAWHEX.
+     */
+    LineEmitter(OutputSink &output, const int &signPerLine, const std::string &quote);
+
+    /**
+     * @brief Appends text to the current unit.
+     *
+     * @param data The converted text.
+     * @param length Number of characters.
+     */
+    void append(const char *data, const std::size_t length);
+
+    /**
+     * @brief Closes the current unit and applies the line break rules.
+     *
+     * @param source The input character the unit was converted from, used for the new line rules.
+     */
+    void endUnit(const unsigned char source = 0);
+
+    /**
+     * @brief Appends a complete unit.
+     *
+     * @param data The converted text of the unit.
+     * @param length Number of characters.
+     * @param source The input character the unit was converted from.
+     */
+    void unit(const char *data, const std::size_t length, const unsigned char source);
+
+    /**
+     * @brief Closes the last unit and writes the last line.
+     */
+    void finish();
+
+private:
+    /**
+     * @brief Writes a part of the current line to the output, with the opening quote in front of the first part.
+     */
+    void writePart(const char *data, const std::size_t length);
+
+    /**
+     * @brief Ends the written line with the closing quote and the line continuation.
+     */
+    void closeLine();
+
+    /**
+     * @brief Ends the line in front of the current unit, the unit becomes the start of the next line.
+     */
+    void breakBeforeUnit();
+
+    /**
+     * @brief Writes and ends the whole current line.
+     */
+    void flushLine();
+
+    OutputSink &output;        /**< Output the lines are written to */
+    const std::string quote;   /**< Quote around each line */
+    std::size_t signPerLine;   /**< Maximum width of a line */
+    bool pendingReturn = false; /**< A CR was seen in DOS mode */
+
+    std::string line;            /**< Part of the current line that is not written yet */
+    std::size_t written = 0;     /**< Number of characters of the current line that are already written */
+    std::size_t unitStart = 0;   /**< Start of the current unit in line */
+    std::size_t unitColumn = 0;  /**< Column the current unit started in */
+    bool lineOpen = false;       /**< The opening quote of the current line is written */
+};
+
+template <NewLineMode Mode>
+inline void LineEmitter<Mode>::append(const char *data, const std::size_t length)
+{
+    line.append(data, length);
+
+    // the unit does not fit behind the text before it anymore, so it moves to the next line already now
+    if (unitColumn > 0 && written + line.size() > signPerLine)
+    {
+        breakBeforeUnit();
+    }
+
+    // a unit that is longer than a whole line can not get anything in front of it, write what we have
+    if (unitColumn == 0 && line.size() > signPerLine)
+    {
+        writePart(line.data(), line.size());
+        line.clear();
+        unitStart = 0;
+    }
+}
+
+template <NewLineMode Mode>
+inline void LineEmitter<Mode>::endUnit(const unsigned char source)
+{
+    const std::size_t column = written + line.size();
+    if (column == unitColumn)
+    {
+        // nothing was added since the last unit
+        return;
+    }
+
+    if (unitColumn > 0 && column > signPerLine)
+    {
+        breakBeforeUnit();
+    }
+
+    unitStart = line.size();
+    unitColumn = written + line.size();
+
+    if constexpr (Mode == NewLineMode::DOS)
+    {
+        // the line ends behind the unit that follows a CR
+        if (source == '\r')
+        {
+            pendingReturn = true;
+        }
+        else if (pendingReturn)
+        {
+            pendingReturn = false;
+            flushLine();
+        }
+    }
+    else if (source == (Mode == NewLineMode::MAC ? '\r' : '\n'))
+    {
+        flushLine();
+    }
+}
+
+template <NewLineMode Mode>
+inline void LineEmitter<Mode>::unit(const char *data, const std::size_t length, const unsigned char source)
+{
+    append(data, length);
+    endUnit(source);
+}
+
+extern template class LineEmitter<NewLineMode::UNIX>;
+extern template class LineEmitter<NewLineMode::DOS>;
+extern template class LineEmitter<NewLineMode::MAC>;
+
+#endif // LINEEMITTER_H
@@ -0,0 +1,133 @@
+/**
+ * @file OutputCache.h
+ * @brief Contains the OutputCache class that keeps the generated files of the input files in a directory shared by several build trees.
+ */
+
+#ifndef OUTPUTCACHE_H
+#define OUTPUTCACHE_H
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include <ByteSource.h>
+
+/**
+ * @brief Version of the cached files, increased whenever the generator writes different files for the same input.
+ */
+constexpr unsigned int OUTPUT_CACHE_VERSION = 2;
+
+/**
+ * @struct CacheKey
+ * @brief Key of an entry of the OutputCache, a 128 bit FNV-1a hash over everything the generated files depend on.
+ *
+ * The cache is shared by build trees and runs, so a key that collides would restore the files of another input.
+ * With 128 bits that does not happen in practice, the key names the entry and is checked in its manifest.
+ */
+struct CacheKey
+{
+    std::uint64_t high = 0x6c62272e07bb0142ull; /**< Upper half, starts with the FNV-1a offset basis */
+    std::uint64_t low = 0x62b821756295c58dull;  /**< Lower half */
+
+    /**
+     * @brief Adds bytes to the key.
+     *
+     * @param data The bytes.
+     * @param length Number of bytes.
+     */
+    void add(const char *data, const std::size_t length);
+
+    /**
+     * @brief Adds a string and its length to the key, so the strings can not run into each other.
+     *
+     * @param text The string.
+     */
+    void addText(const std::string &text);
+
+    /**
+     * @brief Adds a whole source to the key, in chunks.
+     *
+     * @param source The source, it is rewound and read to its end.
+     */
+    void addSource(ByteSource &source);
+
+    /**
+     * @brief Returns the key as 32 hexadecimal digits.
+     */
+    std::string toString() const;
+};
+
+/**
+ * @class OutputCache
+ * @brief Directory with the generated files of earlier runs, found by a key over everything they depend on.
+ *
+ * Every entry is the directory KEY[0..1]/KEY[2..] with a manifest and one file per generated file. The manifest
+ * holds the whole key again, restore() checks it before it copies anything. An entry is written into a directory of
+ * its own and renamed into place, so several runs can use the cache at the same time and never see half an entry.
+ * The manifest is touched on every hit, finish() evicts the entries that were not used the longest until the cache
+ * fits its size again.
+ */
+class OutputCache
+{
+public:
+    /**
+     * @brief Opens the cache, the directory is created if it is missing.
+     *
+     * @param directory The cache directory.
+     * @param maxSize Number of bytes the entries may take, checked by finish().
+     */
+    OutputCache(const std::filesystem::path &directory, const std::uintmax_t maxSize);
+
+    /**
+     * @brief Copies the files of an entry to their places, a file that already has the content keeps its timestamp.
+     *
+     * @param key The key of the input file.
+     * @param headerDirectory Directory the header goes to.
+     * @param sourceDirectory Directory the other files go to.
+     * @param restored The paths of the restored files are appended.
+     * @param unchangedFiles Counts the files that already had the content.
+     * @return False on a miss, also if the entry could not be read completely.
+     */
+    bool restore(const CacheKey &key, const std::filesystem::path &headerDirectory,
+                 const std::filesystem::path &sourceDirectory, std::vector<std::filesystem::path> &restored,
+                 std::size_t &unchangedFiles);
+
+    /**
+     * @brief Adds the generated files of an input file, a cache that can not be written only logs a warning.
+     *
+     * @param key The key of the input file.
+     * @param headerFile The generated header.
+     * @param sourceFiles The other generated files, all in one directory.
+     */
+    void store(const CacheKey &key, const std::filesystem::path &headerFile,
+               const std::vector<std::filesystem::path> &sourceFiles);
+
+    /**
+     * @brief Evicts the least recently used entries if the cache is too big and logs the statistics.
+     *
+     * The counters of this run are added to the file "stats" in the cache directory.
+     */
+    void finish();
+
+private:
+    /**
+     * @brief Returns the directory of the entry of a key.
+     */
+    std::filesystem::path entryPath(const CacheKey &key) const;
+
+    /**
+     * @brief Returns a new directory for an entry that is being written, unique across threads and processes.
+     */
+    std::filesystem::path temporaryPath() const;
+
+    std::filesystem::path directory;     /**< The cache directory */
+    std::uintmax_t maxSize;              /**< Number of bytes the entries may take */
+    std::atomic<std::size_t> hits{0};    /**< Input files restored in this run */
+    std::atomic<std::size_t> misses{0};  /**< Input files generated in this run */
+    std::atomic<std::size_t> stored{0};  /**< Entries added in this run */
+};
+
+#endif // OUTPUTCACHE_H
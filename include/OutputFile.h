@@ -0,0 +1,58 @@
+/**
+ * @file OutputFile.h
+ * @brief Contains the OutputFile class that replaces a generated file only if its content changed.
+ */
+
+#ifndef OUTPUTFILE_H
+#define OUTPUTFILE_H
+
+#include <fstream>
+#include <filesystem>
+
+/**
+ * @class OutputFile
+ * @brief A generated file that keeps its timestamp if it is generated with the same content again.
+ *
+ * The content is written to a temporary file next to the file. commit() compares both and only replaces the
+ * file if they differ, so build tools do not rebuild what depends on an unchanged file.
+ */
+class OutputFile
+{
+public:
+    /**
+     * @brief Opens the temporary file, PATH.tmp.
+     *
+     * @param path Path of the generated file.
+     * @param binary Opens the temporary file in binary mode.
+     * @throws std::runtime_error If the temporary file can not be opened.
+     */
+    explicit OutputFile(const std::filesystem::path &path, const bool binary = false);
+
+    /**
+     * @brief Removes the temporary file if commit() was not called, the file stays as it was.
+     */
+    ~OutputFile();
+
+    /**
+     * @brief Returns the stream the content is written to.
+     */
+    std::ofstream &stream();
+
+    /**
+     * @brief Closes the temporary file and replaces the file with it if their contents differ.
+     *
+     * The sizes are compared first, the contents only if they are equal.
+     *
+     * @return True if the file was written, false if it already had the content.
+     * @throws std::runtime_error If the content could not be written.
+     */
+    bool commit();
+
+private:
+    std::filesystem::path path;          /**< Path of the generated file */
+    std::filesystem::path temporaryPath; /**< Path the content is written to first */
+    std::ofstream file;                  /**< The opened temporary file */
+    bool committed = false;              /**< commit() was called */
+};
+
+#endif // OUTPUTFILE_H
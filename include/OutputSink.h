@@ -0,0 +1,115 @@
+/**
+ * @file OutputSink.h
+ * @brief Contains the OutputSink classes the generated code is written to.
+ */
+
+#ifndef OUTPUTSINK_H
+#define OUTPUTSINK_H
+
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+/**
+ * @class OutputSink
+ * @brief Base class for the target of the generated code.
+ *
+ * Writing the generated code to a sink instead of returning it as string lets a variable be written
+ * to the source file piece by piece, so its converted text never has to be in memory as a whole.
+ */
+class OutputSink
+{
+public:
+    virtual ~OutputSink();
+
+    /**
+     * @brief Writes characters to the sink.
+     *
+     * @param data The characters.
+     * @param length Number of characters.
+     */
+    virtual void write(const char *data, const std::size_t length) = 0;
+
+    /**
+     * @brief Writes a string to the sink.
+     *
+     * @param text The string.
+     */
+    void write(const std::string &text);
+};
+
+/**
+ * @class StringSink
+ * @brief OutputSink that appends to a string in memory.
+ *
+ * It counts how often the string had to allocate its buffer, so a caller that knows the exact size of
+ * the output up front can check that it was written with a single allocation.
+ */
+class StringSink : public OutputSink
+{
+public:
+    /**
+     * @brief Constructs a StringSink that appends to text.
+     *
+     * @param text The string to append to.
+     * @param expectedSize Number of characters that will be appended, reserved at once if not 0.
+     */
+    explicit StringSink(std::string &text, const std::size_t expectedSize = 0);
+
+    using OutputSink::write;
+    void write(const char *data, const std::size_t length) override;
+
+    /**
+     * @brief Returns how often the buffer of the string was allocated since the sink was constructed.
+     */
+    std::size_t allocations() const;
+
+private:
+    std::string &text;               /**< The string to append to */
+    std::size_t capacity;            /**< Last seen capacity of text */
+    std::size_t allocationCount = 0; /**< Number of times the capacity changed */
+};
+
+/**
+ * @class CountingSink
+ * @brief OutputSink that only counts the characters written to it.
+ *
+ * The LineEmitter writes its lines to it like to any other sink, only the count is kept.
+ */
+class CountingSink : public OutputSink
+{
+public:
+    using OutputSink::write;
+    void write(const char *data, const std::size_t length) override;
+
+    /**
+     * @brief Returns the number of characters written so far.
+     */
+    std::size_t size() const;
+
+private:
+    std::size_t count = 0; /**< Characters written so far */
+};
+
+/**
+ * @class StreamSink
+ * @brief OutputSink that writes to an output stream, for example the opened source file.
+ */
+class StreamSink : public OutputSink
+{
+public:
+    /**
+     * @brief Constructs a StreamSink that writes to stream.
+     *
+     * @param stream The stream to write to.
+     */
+    explicit StreamSink(std::ostream &stream);
+
+    using OutputSink::write;
+    void write(const char *data, const std::size_t length) override;
+
+private:
+    std::ostream &stream; /**< The stream to write to */
+};
+
+#endif // OUTPUTSINK_H
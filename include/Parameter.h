@@ -8,6 +8,34 @@
 
 #include <string>
 #include <iostream>
+#include <ios>
+#include <cstddef>
+
+/**
+ * @brief Encoding of a variable, parsed once from VariableStruct::seq.
+ */
+enum class SeqType
+{
+    ESC,   /**< Escape sequences in a string literal */
+    HEX,   /**< "\xNN" fragments in a string literal */
+    OCT,   /**< "\NNN" fragments in a string literal */
+    RAWHEX,   /**< "0xNN" elements of a char array */
+    EMBED,    /**< #embed of a binary file into an unsigned char array, RAWHEX elements without #embed support */
+    RAWHEX32, /**< little endian uint32_t elements, the last one padded with zeros */
+    RAWHEX64, /**< little endian uint64_t elements, the last one padded with zeros */
+    AUTO,     /**< The shortest escape sequence for every character in a string literal */
+    RAW       /**< C++ raw string literals with the content as it is */
+};
+
+/**
+ * @brief New line mode of a variable, parsed once from VariableStruct::nl.
+ */
+enum class NewLineMode
+{
+    UNIX, /**< LF */
+    DOS,  /**< CR LF */
+    MAC   /**< CR */
+};
 
 /**
  * @struct ParamStruct
@@ -22,6 +50,12 @@ struct ParamStruct
     std::string namespaceName;  /**< Namespace yes or no (only for CPP) */
     int signPerLine = 0;        /**< Number of characters per line */
     bool sortByVarname = 0;     /**< sets if variable names should be sorted*/
+    std::size_t parallelThreshold = 0; /**< Content size from which a variable is converted in parallel blocks, 0 = never */
+    bool arrayDefinitions = false; /**< Defines the string variables as char arrays and every variable with a NAME_size constant */
+    bool packedBlob = false; /**< Packs the contents of all variables of a file into one char array with an offset table */
+    bool nameLookup = false; /**< Adds a lookup of the variables by name through a perfect hash to the header */
+    bool variableCache = false; /**< Keeps an index of the converted variables, unchanged ones are copied from the previous source */
+    std::string inputFileName; /**< Name of the input file without extension, the binary files of its EMBED variables start with it */
 };
 
 /**
@@ -37,14 +71,43 @@ struct VariableStruct
 {
     int VariableLineNumber; /**< This is the line where the variable has been defined in the input-File*/
     std::string name;       /**< Name of the variable */
-    std::string seq;        /**< defines what Encoding should be used for the value (ESC, HEX, OCT, RAWHEX) */
+    std::string seq;        /**< defines what Encoding should be used for the value (ESC, HEX, OCT, RAWHEX, EMBED, RAWHEX32, RAWHEX64, AUTO, RAW) */
     std::string nl;         /**< Sets how new line speration should be handled  (DOS = CR LF, MAC = CR, UNIX = LF)*/
     std::string content;    /** The content of the variable*/
     bool addtextpos;        /**< If true. The line of the variable of input-file will be included to the header*/
     bool addtextsegment;    /**< If true. Original text of variable will be added as comment*/
     std::string doxygen;    /**< Text for the doxygen*/
+
+    std::string sourceFile;         /**< If set, the content is read in chunks from this file instead of from content */
+    std::streamoff contentOffset = 0; /**< Stream position of the content in sourceFile */
+    std::size_t contentLength = 0;  /**< Number of characters of the content in sourceFile */
+    std::string contentTail;        /**< Last characters of the content in sourceFile, used for the new line check */
 };
 
+/**
+ * @brief Returns the SeqType for a seq text (ESC, HEX, OCT, RAWHEX, EMBED, RAWHEX32, RAWHEX64, AUTO or RAW), ESC if it is none of them.
+ * @param seq The seq text of a variable.
+ */
+SeqType toSeqType(const std::string &seq);
+
+/**
+ * @brief Returns if a variable with this seq is an array instead of a pointer to a string literal.
+ */
+bool isArraySeq(const SeqType seq);
+
+/**
+ * @brief Returns the number of content bytes that are packed into one array element.
+ *
+ * @return 4 for RAWHEX32, 8 for RAWHEX64 and 1 for every other seq.
+ */
+std::size_t seqWordSize(const SeqType seq);
+
+/**
+ * @brief Returns the NewLineMode for a nl text (UNIX, DOS or MAC), UNIX if it is none of them.
+ * @param nl The nl text of a variable.
+ */
+NewLineMode toNewLineMode(const std::string &nl);
+
 /**
  * @brief Prints the information contained in a VariableStruct object.
  * @param variableStruct The VariableStruct object to print.
@@ -0,0 +1,67 @@
+/**
+ * @file PerfectHash.h
+ * @brief Contains the functions that build a collision free hash over the variable names of a file.
+ */
+
+#ifndef PERFECTHASH_H
+#define PERFECTHASH_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @struct PerfectHash
+ * @brief Tables of a hash and displace perfect hash, every name has a slot of its own.
+ *
+ * The first hash of a name selects its bucket, the displacement of the bucket is the seed of the second hash,
+ * which selects the slot. Both table sizes are powers of two, so the hashes are masked instead of divided.
+ */
+struct PerfectHash
+{
+    std::vector<std::uint32_t> displacements; /**< Seed of the second hash per bucket */
+    std::vector<std::uint32_t> slots;         /**< Index of the name per slot, 0 for the free slots */
+};
+
+/**
+ * @brief Hashes a name with a seed, FNV-1a with a final mix of the bits.
+ *
+ * The generated lookup computes the same values, see writeHashFunction().
+ *
+ * @param name The name.
+ * @param seed 0 for the bucket, the displacement of the bucket for the slot.
+ * @return The hash value.
+ */
+std::uint32_t hashName(const std::string &name, const std::uint32_t seed);
+
+/**
+ * @brief Builds the tables for a set of unique names.
+ *
+ * The buckets with the most names are placed first, each gets the first displacement that puts its names into
+ * free slots. If a bucket finds none, the slot table is doubled and the search starts again.
+ *
+ * @param names The unique names.
+ * @return The tables, one slot per name at least.
+ * @throws std::invalid_argument If no tables are found within 64 slots per name, e.g. for a name given twice.
+ */
+PerfectHash buildPerfectHash(const std::vector<std::string> &names);
+
+/**
+ * @brief Returns the slot of a name, as the generated lookup finds it.
+ *
+ * @param hash Tables built by buildPerfectHash().
+ * @param name The name, it does not have to be one of the names the tables were built for.
+ * @return The slot, the caller compares its name with the one looked up.
+ */
+std::size_t findSlot(const PerfectHash &hash, const std::string &name);
+
+/**
+ * @brief Returns the C code of hashName() as static inline function.
+ *
+ * @param functionName Name of the generated function.
+ * @return The function, it takes the name, its length and the seed.
+ */
+std::string writeHashFunction(const std::string &functionName);
+
+#endif // PERFECTHASH_H
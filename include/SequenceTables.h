@@ -0,0 +1,100 @@
+/**
+ * @file SequenceTables.h
+ * @brief Contains compile time lookup tables with the finished HEX, OCT and RAWHEX fragment of every byte.
+ */
+
+#ifndef SEQUENCETABLES_H
+#define SEQUENCETABLES_H
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @brief Table with one fixed width fragment for each of the 256 byte values.
+ */
+template <std::size_t Width>
+using FragmentTable = std::array<std::array<char, Width>, 256>;
+
+constexpr std::size_t HEX_FRAGMENT_WIDTH = 4;    /**< Width of a "\xNN" fragment */
+constexpr std::size_t OCT_FRAGMENT_WIDTH = 4;    /**< Width of a "\NNN" fragment */
+constexpr std::size_t RAWHEX_FRAGMENT_WIDTH = 6; /**< Width of a "0xNN, " fragment */
+
+/**
+ * @brief Returns the lowercase hexadecimal digit of a value from 0 to 15.
+ */
+constexpr char hexDigit(const unsigned int value)
+{
+    return static_cast<char>(value < 10 ? '0' + value : 'a' + value - 10);
+}
+
+/**
+ * @brief Builds the table with the "\xNN" fragments.
+ */
+constexpr FragmentTable<HEX_FRAGMENT_WIDTH> makeHexTable()
+{
+    FragmentTable<HEX_FRAGMENT_WIDTH> table{};
+    for (unsigned int i = 0; i < 256; i++)
+    {
+        table[i][0] = '\\';
+        table[i][1] = 'x';
+        table[i][2] = hexDigit(i >> 4);
+        table[i][3] = hexDigit(i & 0xf);
+    }
+    return table;
+}
+
+/**
+ * @brief Builds the table with the "\NNN" fragments.
+ */
+constexpr FragmentTable<OCT_FRAGMENT_WIDTH> makeOctTable()
+{
+    FragmentTable<OCT_FRAGMENT_WIDTH> table{};
+    for (unsigned int i = 0; i < 256; i++)
+    {
+        table[i][0] = '\\';
+        table[i][1] = static_cast<char>('0' + (i >> 6));
+        table[i][2] = static_cast<char>('0' + ((i >> 3) & 07));
+        table[i][3] = static_cast<char>('0' + (i & 07));
+    }
+    return table;
+}
+
+/**
+ * @brief Builds the table with the "0xNN, " fragments.
+ */
+constexpr FragmentTable<RAWHEX_FRAGMENT_WIDTH> makeRawHexTable()
+{
+    FragmentTable<RAWHEX_FRAGMENT_WIDTH> table{};
+    for (unsigned int i = 0; i < 256; i++)
+    {
+        table[i][0] = '0';
+        table[i][1] = 'x';
+        table[i][2] = hexDigit(i >> 4);
+        table[i][3] = hexDigit(i & 0xf);
+        table[i][4] = ',';
+        table[i][5] = ' ';
+    }
+    return table;
+}
+
+inline constexpr FragmentTable<HEX_FRAGMENT_WIDTH> HEX_TABLE = makeHexTable();          /**< "\xNN" of every byte */
+inline constexpr FragmentTable<OCT_FRAGMENT_WIDTH> OCT_TABLE = makeOctTable();          /**< "\NNN" of every byte */
+inline constexpr FragmentTable<RAWHEX_FRAGMENT_WIDTH> RAWHEX_TABLE = makeRawHexTable(); /**< "0xNN, " of every byte */
+
+/**
+ * @brief Copies the fragment of a byte to the output buffer.
+ *
+ * @param output Position in the preallocated output buffer.
+ * @param table The fragment table of the sequence type.
+ * @param c The byte to encode.
+ * @return The position after the written fragment.
+ */
+template <std::size_t Width>
+inline char *writeFragment(char *output, const FragmentTable<Width> &table, const unsigned char c)
+{
+    std::memcpy(output, table[c].data(), Width);
+    return output + Width;
+}
+
+#endif // SEQUENCETABLES_H
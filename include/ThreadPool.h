@@ -0,0 +1,125 @@
+/**
+ * @file ThreadPool.h
+ * @brief Contains the ThreadPool class that runs conversion work on worker threads.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief A fixed set of worker threads that run submitted tasks in order of submission.
+ *
+ * A thread that waits for a result with wait() runs queued tasks in the meantime. So tasks can submit
+ * and wait for further tasks of the same pool (files -> variables -> chunks) without blocking all workers.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param threads Number of worker threads, at least one.
+     */
+    explicit ThreadPool(const std::size_t threads);
+
+    /**
+     * @brief Runs the remaining tasks and joins the worker threads.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Queues a task.
+     *
+     * @param function The task, called without arguments.
+     * @return Future with the result of the task.
+     */
+    template <typename Function>
+    auto submit(Function function) -> std::future<decltype(function())>
+    {
+        using Result = decltype(function());
+        const auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+        std::future<Result> result = task->get_future();
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace_back([task]()
+                               { (*task)(); });
+        }
+        condition.notify_one();
+        return result;
+    }
+
+    /**
+     * @brief Waits for the result of a task and runs queued tasks while waiting.
+     *
+     * @param future The future returned by submit().
+     * @return The result of the task, an exception of the task is thrown again.
+     */
+    template <typename Result>
+    Result wait(std::future<Result> &future)
+    {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            if (!runPendingTask())
+            {
+                future.wait_for(std::chrono::microseconds(100));
+            }
+        }
+        return future.get();
+    }
+
+    /**
+     * @brief Returns the number of worker threads.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Returns the pool that is shared by the whole program.
+     *
+     * It is created on first use with the size given to setSharedSize(), or one thread per CPU core.
+     */
+    static ThreadPool &shared();
+
+    /**
+     * @brief Sets the number of threads of the shared pool, has to be called before its first use.
+     *
+     * @param threads Number of threads, 0 for one per CPU core.
+     */
+    static void setSharedSize(const std::size_t threads);
+
+private:
+    /**
+     * @brief Takes one queued task and runs it on the calling thread.
+     *
+     * @return False if no task was queued.
+     */
+    bool runPendingTask();
+
+    /**
+     * @brief Main loop of a worker thread.
+     */
+    void work();
+
+    std::vector<std::thread> workers;         /**< The worker threads */
+    std::deque<std::function<void()>> tasks; /**< Queued tasks */
+    std::mutex mutex;                         /**< Protects tasks and stopping */
+    std::condition_variable condition;        /**< Signals new tasks and stopping */
+    bool stopping = false;                    /**< Set when the pool is destroyed */
+
+    static std::size_t sharedSize; /**< Size of the shared pool, 0 for one thread per CPU core */
+};
+
+#endif // THREADPOOL_H
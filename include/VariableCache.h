@@ -0,0 +1,131 @@
+/**
+ * @file VariableCache.h
+ * @brief Contains the VariableCache class that finds the converted variables of the previous run in its source file.
+ */
+
+#ifndef VARIABLECACHE_H
+#define VARIABLECACHE_H
+
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+#include <ByteSource.h>
+#include <OutputSink.h>
+#include <OutputFile.h>
+
+/**
+ * @brief Version of the cache, increased whenever a converter writes different code for the same input.
+ */
+constexpr unsigned int VARIABLE_CACHE_VERSION = 1;
+
+/**
+ * @brief Start value of the hashes of the cache keys, the FNV-1a offset basis.
+ */
+constexpr std::uint64_t CACHE_HASH_BASIS = 14695981039346656037ull;
+
+/**
+ * @brief Adds bytes to a hash, FNV-1a.
+ *
+ * @param hash The hash so far.
+ * @param data The bytes.
+ * @param length Number of bytes.
+ * @return The new hash.
+ */
+std::uint64_t hashBytes(std::uint64_t hash, const char *data, const std::size_t length);
+
+/**
+ * @brief Adds a string and its length to a hash, so the strings of a key can not run into each other.
+ *
+ * @param hash The hash so far.
+ * @param text The string.
+ * @return The new hash.
+ */
+std::uint64_t hashText(const std::uint64_t hash, const std::string &text);
+
+/**
+ * @brief Adds a whole source to a hash, in chunks.
+ *
+ * @param hash The hash so far.
+ * @param source The source, it is rewound and read to its end.
+ * @return The new hash.
+ */
+std::uint64_t hashSource(const std::uint64_t hash, ByteSource &source);
+
+/**
+ * @class VariableCache
+ * @brief Index of the converted variables in a generated source file, stored in the file SOURCE.cache next to it.
+ *
+ * Every variable is indexed by a key, a hash of everything its code depends on, with the position of its code in
+ * the source. The next run copies the code of every key it finds from the previous source instead of converting
+ * the variable again. The previous source stays in place until the new one is committed, see OutputFile. The index
+ * holds the size and time of the source it was written for and is not used for any other one.
+ * The previous source is read in binary mode, so the new one has to be written in binary mode as well; in text
+ * mode a new line would be written as CR LF on Windows and copied as CR CR LF the next time.
+ */
+class VariableCache
+{
+public:
+    /**
+     * @brief Reads the index of the previous run, an index that is missing or does not fit the source is left empty.
+     *
+     * @param sourceFilePath Path of the generated source file.
+     */
+    explicit VariableCache(const std::filesystem::path &sourceFilePath);
+
+    /**
+     * @brief Returns if the previous source has the code of a key.
+     */
+    bool contains(const std::uint64_t key) const;
+
+    /**
+     * @brief Copies the code of a key from the previous source.
+     *
+     * @param key A key for which contains() is true.
+     * @param sink The sink the code is written to.
+     * @return Number of characters written.
+     */
+    std::size_t copy(const std::uint64_t key, OutputSink &sink);
+
+    /**
+     * @brief Adds the code of a variable in the new source to the new index.
+     *
+     * @param key The key of the variable.
+     * @param offset Position of the code in the new source, which is written in binary mode.
+     * @param length Number of characters of the code.
+     */
+    void record(const std::uint64_t key, const std::size_t offset, const std::size_t length);
+
+    /**
+     * @brief Commits the new source and writes the index for it, the old index is replaced.
+     *
+     * The previous source is closed first, so it can be replaced.
+     *
+     * @param sourceFile The new source.
+     * @return The result of OutputFile::commit(), false if the source was unchanged.
+     * @throws std::runtime_error If the source or the index can not be written.
+     */
+    bool commit(OutputFile &sourceFile);
+
+private:
+    /**
+     * @struct Range
+     * @brief Position of the code of a variable in a source.
+     */
+    struct Range
+    {
+        std::size_t offset; /**< Position of the first character */
+        std::size_t length; /**< Number of characters */
+    };
+
+    std::filesystem::path sourceFilePath;                   /**< Path of the generated source */
+    std::filesystem::path cacheFilePath;                    /**< Path of the index, SOURCE.cache */
+    std::unordered_map<std::uint64_t, Range> previous;     /**< Index of the previous source */
+    std::unordered_map<std::uint64_t, Range> current;      /**< Index of the new source */
+    std::ifstream previousSource;                           /**< The previous source, open while it is indexed */
+};
+
+#endif // VARIABLECACHE_H
@@ -0,0 +1,164 @@
+#include <iomanip>
+#include <sstream>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ASCII_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#include <AsciiValidator.h>
+
+namespace
+{
+    /**
+     * @brief Signature of a check kernel, returns the offset of the first non ASCII byte or length.
+     */
+    using FindFunction = std::size_t (*)(const unsigned char *data, std::size_t length);
+
+    std::size_t findScalar(const unsigned char *data, const std::size_t length)
+    {
+        std::size_t i = 0;
+        while (i < length && data[i] < 0x80)
+        {
+            i++;
+        }
+        return i;
+    }
+
+#ifdef ASCII_SIMD_X86
+    __attribute__((target("sse2"))) std::size_t findSSE2(const unsigned char *data, const std::size_t length)
+    {
+        // the sign bit of every byte is the non ASCII bit, four blocks are merged before the test
+        std::size_t i = 0;
+        for (; i + 64 <= length; i += 64)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 16));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 32));
+            const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 48));
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) != 0)
+            {
+                break;
+            }
+        }
+        for (; i + 16 <= length; i += 16)
+        {
+            const int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)));
+            if (mask != 0)
+            {
+                return i + __builtin_ctz(static_cast<unsigned int>(mask));
+            }
+        }
+        return i + findScalar(data + i, length - i);
+    }
+
+    __attribute__((target("avx2"))) std::size_t findAVX2(const unsigned char *data, const std::size_t length)
+    {
+        std::size_t i = 0;
+        for (; i + 128 <= length; i += 128)
+        {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 32));
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 64));
+            const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 96));
+            if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d))) != 0)
+            {
+                break;
+            }
+        }
+        for (; i + 32 <= length; i += 32)
+        {
+            const int mask = _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)));
+            if (mask != 0)
+            {
+                return i + __builtin_ctz(static_cast<unsigned int>(mask));
+            }
+        }
+        return i + findSSE2(data + i, length - i);
+    }
+#endif
+
+    // picks the widest kernel the running CPU supports
+    FindFunction selectFindFunction()
+    {
+#ifdef ASCII_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return findAVX2;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return findSSE2;
+        }
+#endif
+        return findScalar;
+    }
+}
+
+std::size_t findNonAscii(const char *data, const std::size_t length)
+{
+    static const FindFunction find = selectFindFunction();
+    return find(reinterpret_cast<const unsigned char *>(data), length);
+}
+
+std::vector<AsciiError> validateAscii(ByteSource &source, const int firstLine)
+{
+    std::vector<AsciiError> errors;
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::size_t length;
+
+    // first pass: only look for the sign bits
+    bool valid = true;
+    while (valid && (length = source.read(buffer.data(), buffer.size())) > 0)
+    {
+        valid = findNonAscii(buffer.data(), length) == length;
+    }
+    source.rewind();
+    if (valid)
+    {
+        return errors;
+    }
+
+    // second pass: count lines and columns up to every error
+    int line = firstLine;
+    std::size_t column = 1;
+    while ((length = source.read(buffer.data(), buffer.size())) > 0)
+    {
+        std::size_t pos = 0;
+        while (pos < length)
+        {
+            const std::size_t next = pos + findNonAscii(buffer.data() + pos, length - pos);
+            for (std::size_t i = pos; i < next; i++)
+            {
+                if (buffer[i] == '\n')
+                {
+                    line++;
+                    column = 1;
+                }
+                else
+                {
+                    column++;
+                }
+            }
+            if (next == length)
+            {
+                break;
+            }
+
+            errors.push_back({line, column, static_cast<unsigned char>(buffer[next])});
+            column++;
+            pos = next + 1;
+        }
+    }
+    source.rewind();
+    return errors;
+}
+
+std::string describeAsciiError(const AsciiError &error, const std::string &inputFile)
+{
+    std::ostringstream text;
+    text << "ASCII ERROR in: " << inputFile << " in line: " << error.line << " column: " << error.column
+         << " (0x" << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << static_cast<int>(error.value) << ")";
+    return text.str();
+}
@@ -0,0 +1,136 @@
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <stdexcept>
+
+#include <ByteSource.h>
+#include <OutputFile.h>
+
+ByteSource::~ByteSource()
+{
+}
+
+StringSource::StringSource(const std::string &text, const std::size_t length) : text(text), length(std::min(length, text.size()))
+{
+}
+
+StringSource::StringSource(const std::string &text) : StringSource(text, text.size())
+{
+}
+
+std::size_t StringSource::size() const
+{
+    return length;
+}
+
+std::size_t StringSource::read(char *buffer, const std::size_t length)
+{
+    const std::size_t count = std::min(length, this->length - position);
+    std::memcpy(buffer, text.data() + position, count);
+    position += count;
+    return count;
+}
+
+void StringSource::rewind()
+{
+    position = 0;
+}
+
+FileRangeSource::FileRangeSource(const std::string &filePath, const std::streamoff &offset, const std::size_t length)
+    : filePath(filePath), offset(offset), length(length)
+{
+}
+
+std::size_t FileRangeSource::size() const
+{
+    return length;
+}
+
+std::size_t FileRangeSource::read(char *buffer, const std::size_t length)
+{
+    const std::size_t count = std::min(length, this->length - position);
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    // the file is only closed at the end of the range or by rewind(), so it is opened at the start of the range
+    if (!file.is_open())
+    {
+        file.open(filePath);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Could not open: " + filePath);
+        }
+        file.seekg(offset);
+    }
+
+    file.read(buffer, static_cast<std::streamsize>(count));
+    const std::size_t got = static_cast<std::size_t>(file.gcount());
+    position += got;
+    if (position == this->length)
+    {
+        file.close();
+    }
+    return got;
+}
+
+void FileRangeSource::rewind()
+{
+    file.close();
+    file.clear();
+    position = 0;
+}
+
+ConcatSource::ConcatSource(std::vector<std::unique_ptr<ByteSource>> parts) : parts(std::move(parts))
+{
+    for (const std::unique_ptr<ByteSource> &part : this->parts)
+    {
+        length += part->size();
+        part->rewind();
+    }
+}
+
+std::size_t ConcatSource::size() const
+{
+    return length;
+}
+
+std::size_t ConcatSource::read(char *buffer, const std::size_t length)
+{
+    // fills the buffer across the ends of the parts, so the chunks are as large as with one source
+    std::size_t count = 0;
+    while (count < length && current < parts.size())
+    {
+        const std::size_t got = parts[current]->read(buffer + count, length - count);
+        if (got == 0)
+        {
+            current++;
+        }
+        count += got;
+    }
+    return count;
+}
+
+void ConcatSource::rewind()
+{
+    for (const std::unique_ptr<ByteSource> &part : parts)
+    {
+        part->rewind();
+    }
+    current = 0;
+}
+
+bool copyToFile(ByteSource &source, const std::string &filePath)
+{
+    OutputFile file(filePath, true);
+
+    source.rewind();
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::size_t count;
+    while ((count = source.read(buffer.data(), buffer.size())) > 0)
+    {
+        file.stream().write(buffer.data(), static_cast<std::streamsize>(count));
+    }
+    return file.commit();
+}
@@ -0,0 +1,150 @@
+#include <iostream>
+#include <vector>
+
+#include <CTextToAutoSeq.h>
+
+namespace
+{
+    // true for the characters that are not written as they are, and for spaces, where the words end
+    inline bool isSpecial(const unsigned char c)
+    {
+        return c < ' ' || c >= 0x7F || c == '\\' || c == '\"' || c == '\?' || c == ' ';
+    }
+
+    // true for the characters that get an octal escape sequence, its width depends on the character behind it
+    inline bool needsNext(const unsigned char c)
+    {
+        return (c < '\a' || c > '\r') && (c < ' ' || c >= 0x7F);
+    }
+
+    /**
+     * @brief Writes the shortest escape sequence of a special character.
+     *
+     * @param c The special character, not a space.
+     * @param previous The character in front of it, -1 at the start of the content.
+     * @param next The character behind it, -1 at the end of the content.
+     * @param out Room for at least four characters.
+     * @return Number of characters written.
+     */
+    std::size_t writeEscape(const unsigned char c, const int previous, const int next, char *out)
+    {
+        static const char NAMED[] = "abtnvfr"; // '\a' to '\r'
+        out[0] = '\\';
+        if (c >= '\a' && c <= '\r')
+        {
+            out[1] = NAMED[c - '\a'];
+            return 2;
+        }
+        if (c == '\\' || c == '\"')
+        {
+            out[1] = static_cast<char>(c);
+            return 2;
+        }
+        if (c == '\?')
+        {
+            // trigraphs are replaced before escape sequences, so no two '?' may follow each other in the text
+            if (previous == '\?')
+            {
+                out[1] = '\?';
+                return 2;
+            }
+            out[0] = '\?';
+            return 1;
+        }
+
+        // an octal escape sequence ends after three digits, so a digit behind it only needs all three
+        const bool fullWidth = next >= '0' && next <= '7';
+        std::size_t length = 1;
+        if (fullWidth || c >= 0100)
+        {
+            out[length++] = static_cast<char>('0' + (c >> 6));
+        }
+        if (fullWidth || c >= 010)
+        {
+            out[length++] = static_cast<char>('0' + ((c >> 3) & 7));
+        }
+        out[length++] = static_cast<char>('0' + (c & 7));
+        return length;
+    }
+}
+
+template <typename Emitter>
+void CTextToAutoSeq::encodeLines(ByteSource &source, Emitter &emitter)
+{
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::size_t length;
+    char escape[4];
+
+    // the character that waits for the next one, -1 if there is none, and the one in front of the current chunk
+    int held = -1;
+    int previous = -1;
+    const auto writeHeld = [&](const int next)
+    {
+        emitter.append(escape, writeEscape(static_cast<unsigned char>(held), -1, next, escape));
+        held = -1;
+    };
+
+    // a word ends behind each space, new line characters are words of their own
+    while ((length = source.read(buffer.data(), buffer.size())) > 0)
+    {
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < length; i++)
+        {
+            const unsigned char c = static_cast<unsigned char>(buffer[i]);
+            if (held >= 0)
+            {
+                writeHeld(c);
+            }
+            if (!isSpecial(c))
+            {
+                continue;
+            }
+
+            emitter.append(buffer.data() + pos, i - pos);
+            pos = i + 1;
+            if (c == ' ')
+            {
+                emitter.append(" ", 1);
+                emitter.endUnit();
+            }
+            else if (c == '\n' || c == '\r')
+            {
+                emitter.endUnit();
+                emitter.unit(c == '\n' ? "\\n" : "\\r", 2, c);
+            }
+            else if (needsNext(c))
+            {
+                held = c;
+            }
+            else
+            {
+                const int before = i > 0 ? static_cast<unsigned char>(buffer[i - 1]) : previous;
+                emitter.append(escape, writeEscape(c, before, -1, escape));
+            }
+        }
+        emitter.append(buffer.data() + pos, length - pos);
+        previous = static_cast<unsigned char>(buffer[length - 1]);
+    }
+    if (held >= 0)
+    {
+        writeHeld(-1);
+    }
+    emitter.endUnit();
+}
+
+void CTextToAutoSeq::encode(ByteSource &source, OutputSink &sink, const std::string &quotes,
+                            const std::size_t, const std::size_t)
+{
+    withLineEmitter(sink, quotes, [&](auto &emitter)
+                    { encodeLines(source, emitter); });
+}
+
+// constructor to initialize an instance of the CTextToAutoSeq class
+CTextToAutoSeq::CTextToAutoSeq(const VariableStruct &variable, const ParamStruct &parameter) : CTextToCPP(variable, parameter)
+{
+}
+
+// destructor for the CTextToAutoSeq class
+CTextToAutoSeq::~CTextToAutoSeq()
+{
+}
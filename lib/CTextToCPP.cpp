@@ -3,275 +3,658 @@
 #include <fstream>
 #include <iomanip>
 #include <sstream>
-#include <boost/algorithm/string.hpp>
+#include <memory>
+#include <deque>
+#include <future>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 
-#include <Logger.h>
-#include <ConsoleColors.h>
+#include <ThreadPool.h>
+#include <VariableCache.h>
 
 #include <CTextToCPP.h>
 
-void CTextToCPP::checkASCII(const unsigned char &input, const int &line, const unsigned int &pos, const std::string &inputFile)
+namespace
 {
-    const int value = static_cast<int>(input);
-    if (value >= 0x80)
+    /**
+     * @brief Number of content bytes a block of the parallel conversion has at least.
+     */
+    constexpr std::size_t PARALLEL_BLOCK_SIZE = 16 * SOURCE_CHUNK_SIZE;
+
+    /**
+     * @class PrefixedSource
+     * @brief ByteSource over a string that is followed by the not yet read rest of another source.
+     *
+     * The rest is read only once, so the source can not be rewound.
+     */
+    class PrefixedSource : public ByteSource
     {
-        BOOST_LOG_TRIVIAL(fatal) << RED_COLOR << "ASCII ERROR in: " << BLUE_COLOR << inputFile << RED_COLOR
-                                 << " in line: " << line << ORANGE_COLOR << " it is the: " << pos << " character" << RESET_COLOR << std::endl;
-        exit(1);
-    }
+    public:
+        PrefixedSource(const std::string &prefix, ByteSource &rest, const std::size_t restLength)
+            : prefix(prefix), rest(rest), length(prefix.size() + restLength)
+        {
+        }
+
+        std::size_t size() const override
+        {
+            return length;
+        }
+
+        std::size_t read(char *buffer, const std::size_t length) override
+        {
+            if (position < prefix.size())
+            {
+                const std::size_t count = std::min(length, prefix.size() - position);
+                std::memcpy(buffer, prefix.data() + position, count);
+                position += count;
+                return count;
+            }
+            return rest.read(buffer, length);
+        }
+
+        void rewind() override
+        {
+            throw std::logic_error("A partly read content can not be rewound");
+        }
+
+    private:
+        const std::string &prefix; /**< Bytes that are returned first */
+        ByteSource &rest;          /**< Source with the bytes behind the prefix */
+        std::size_t length;        /**< Size of prefix and rest together */
+        std::size_t position = 0;  /**< Next character of the prefix to read */
+    };
 }
 
-void CTextToCPP::checkNewLine(std::string &input, const std::string &nl)
+void CTextToCPP::checkNewLine(std::string &input, const NewLineMode nl)
 {
-    int width = 1;
-    std::string newLineSeperator;
-
-    if (nl == "DOS")
+    std::string newLineSeperator = "\n";
+    if (nl == NewLineMode::DOS)
     {
-        width = 2;
         newLineSeperator = "\r\n";
     }
-    else if (nl == "MAC")
+    else if (nl == NewLineMode::MAC)
     {
         newLineSeperator = "\r";
     }
-    else if (nl == "UNIX")
-    {
-        newLineSeperator = "\n";
-    }
 
+    const std::size_t width = newLineSeperator.size();
     if (input.substr((input.length() - width)) == newLineSeperator)
     {
         input.erase((input.length() - width));
     }
 }
 
-// Function to insert line breaks after certain amount of signs per line
-std::vector<std::string> CTextToCPP::insertLineBreaks(const int &signPerLine, const std::string &text, const std::string &nl, const std::string &seq)
+/**
+ * @brief Function to generate content of header file.
+ * @return declarationText Text to be declared in header file.
+ */
+std::string CTextToCPP::writeDeclaration(const bool external)
+{ // header stuff
+    /**
+     * @brief Holds the generated declaration code.
+     */
+    std::string declarationText = writeDoxygen();
+
+    if (external)
+    {
+        declarationText.append("extern ");
+    }
+    declarationText.append(writeDefinitionHead());
+    declarationText.append(";\n");
+
+    // the packed elements can end with padding and the length of an array should not be scanned,
+    // so the length of the content is given as constant
+    if (hasSizeConstant())
+    {
+        declarationText.append(sizeConstant(variable.name, openContent()->size()));
+    }
+
+    return declarationText;
+}
+
+std::string CTextToCPP::writeDoxygen() const
 {
+    std::string doxygenText;
 
-    char separator = ' ';
-    std::string newLineChar = "\\n";
-    std::string returnChar = "\\r";
+    // Check Doxygentext
+    if (!variable.doxygen.empty())
+    {
+        doxygenText.append("/** " + variable.doxygen);
+        if (variable.addtextpos)
+        {
+            doxygenText.append(" (aus Zeile" + std::to_string(variable.VariableLineNumber) + " ) ");
+        }
+        doxygenText.append("*/\n");
+    }
+    return doxygenText;
+}
 
-    /**
-     * @brief Assign characters for separation, new line and carriage return for each text type.
-     */
-    if (seq == "RAWHEX")
+std::string CTextToCPP::writeDefinitionHead() const
+{
+    if (seqType == SeqType::EMBED)
     {
-        separator = ',';
-        newLineChar = "0x0a";
-        returnChar = "0x0d";
+        return "const unsigned char " + variable.name + "[]";
     }
-    else if (seq == "HEX")
+    if (seqType == SeqType::RAWHEX32)
     {
-        separator = '\\';
-        newLineChar = "x0a";
-        returnChar = "x0d";
+        return "const uint32_t " + variable.name + "[]";
     }
-    else if (seq == "OCT")
+    if (seqType == SeqType::RAWHEX64)
     {
-        separator = '\\';
-        newLineChar = "012";
-        returnChar = "015";
+        return "const uint64_t " + variable.name + "[]";
     }
+    if (seqType == SeqType::RAWHEX || parameter.arrayDefinitions)
+    {
+        return "const char " + variable.name + "[]";
+    }
+    return "const char *const " + variable.name;
+}
 
-    std::vector<std::string> result;
-    std::string line;
+bool CTextToCPP::hasSizeConstant() const
+{
+    return parameter.arrayDefinitions || seqWordSize(seqType) > 1;
+}
 
-    int count = 0;
+std::uint64_t CTextToCPP::implementationKey()
+{
+    // the parallel threshold is left out, the parallel blocks write the same code
+    std::uint64_t key = hashText(CACHE_HASH_BASIS, variable.name);
+    key = hashText(key, variable.seq);
+    key = hashText(key, variable.nl);
+    key = hashText(key, variable.addtextsegment ? "textsegment" : "");
+    key = hashText(key, sharedContent ? "shared" : "");
+    key = hashText(key, exportedContent ? "exported" : "");
+    key = hashText(key, std::to_string(parameter.signPerLine));
+    key = hashText(key, parameter.arrayDefinitions ? "arraydefinitions" : "");
+    const std::unique_ptr<ByteSource> source = openContent();
+    return hashSource(key, *source);
+}
 
-    std::vector<std::string> characters;
-    std::stringstream ss(text);
-    std::string item;
+void CTextToCPP::shareContent()
+{
+    sharedContent = true;
+}
 
-    /**
-     * @brief Extract substrings from text using separator as delimiter and adding them to characters.
-     */
-    while (std::getline(ss, item, separator))
+void CTextToCPP::exportContent()
+{
+    sharedContent = true;
+    exportedContent = true;
+}
 
+std::string CTextToCPP::writeAliasDefinition(const std::string &targetName, const std::size_t offset) const
+{
+    std::string definition = writeDefinitionHead() + " = " + targetName + "_content";
+    if (offset > 0)
     {
-        // Have to look ESC sequnces separately cause they are sticky
-        // Divide them again and look if we find line seperators and add them seperately to the characters
-        if (seq == "ESC")
-        {
-            // find positions of newlineSeperators
-            std::vector<size_t> positions;
-            for (size_t i = 0; i < item.size(); ++i)
-            {
-                std::string complete = item.substr(i, 2);
-                if (complete == newLineChar || complete == returnChar)
-                {
-                    positions.push_back(i);
-                    i += 1;
-                }
-            }
+        definition.append(" + " + std::to_string(offset));
+    }
+    return definition + ";\n";
+}
 
-            // Adding to the Characters
-            size_t startPos = 0;
-            for (size_t pos : positions)
-            {
-                characters.push_back(item.substr(startPos, pos - startPos));
-                characters.push_back(item.substr(pos, 2)); // Add the line break character as a separate substring
-                startPos = pos + 2;
-            }
+std::string CTextToCPP::writeBlobAccessor(const std::string &blobName, const std::size_t offset)
+{
+    // the offset is a constant, so the accessor is inlined to the address of the blob without a relocation of its own
+    std::string accessor = writeDoxygen() + "static inline const char *" + variable.name + "(void) { return " + blobName;
+    if (offset > 0)
+    {
+        accessor.append(" + " + std::to_string(offset));
+    }
+    return accessor + "; }\n" + sizeConstant(variable.name, openContent()->size());
+}
 
-            if (startPos < item.size())
-            {
-                characters.push_back(item.substr(startPos));
-            }
-        }
-        else
-        {
-            characters.push_back(item);
-        }
+std::string CTextToCPP::sizeConstant(const std::string &name, const std::size_t size)
+{
+    return "static const size_t " + name + "_size = " + std::to_string(size) + ";\n";
+}
+
+std::string CTextToCPP::embedFileName() const
+{
+    return parameter.inputFileName + "_" + variable.name + ".bin";
+}
+
+std::string CTextToCPP::embedFilePath() const
+{
+    const std::string binaryName = embedFileName();
+    return parameter.sourceDir.empty() ? binaryName : parameter.sourceDir + "\\" + binaryName;
+}
+
+/**
+ * @brief Opens the content of the variable, without the trailing new line.
+ * @return Source over the content, from memory or in chunks from the input file.
+ */
+std::unique_ptr<ByteSource> CTextToCPP::openContent()
+{
+    // only the tail of the content is needed for the new line check, so the content itself is not changed
+    const bool inMemory = variable.sourceFile.empty();
+    const std::size_t length = inMemory ? variable.content.size() : variable.contentLength;
+    const std::string fullTail = inMemory ? variable.content.substr(length - std::min<std::size_t>(length, 2)) : variable.contentTail;
+
+    std::string tail = fullTail;
+    checkNewLine(tail, newLineMode);
+    const std::size_t trimmed = length - (fullTail.size() - tail.size());
+
+    if (inMemory)
+    {
+        return std::make_unique<StringSource>(variable.content, trimmed);
     }
+    return std::make_unique<FileRangeSource>(variable.sourceFile, variable.contentOffset, trimmed);
+}
 
-    bool dosNext = false;
+std::vector<AsciiError> CTextToCPP::checkContent()
+{
+    // the content starts in the line behind @variable
+    const std::unique_ptr<ByteSource> source = openContent();
+    return validateAscii(*source, variable.VariableLineNumber + 1);
+}
 
-    // Creating the result string with a speicifig length
-    // if existing newline it creates new element so later it can be used as separte line
-    for (size_t i = 0; i < characters.size(); i++)
+/**
+ * @brief Function to generate text of the source file.
+ * The text is to be converted and new lines are to be inserted.
+ * @return Source text.
+ */
+std::string CTextToCPP::writeImplementation()
+{ // source stuff
+    /**
+     * @brief Holds the generated source code.
+     */
+    std::string sourceText;
+    StringSink sink(sourceText, implementationSize());
+    writeImplementation(sink);
+
+    return sourceText;
+}
+
+std::size_t CTextToCPP::implementationSize()
+{
+    const std::unique_ptr<ByteSource> source = openContent();
+    std::size_t size = writeDefinitionOpening().size() + writeDefinitionClosing().size();
+
+    const std::size_t quoteSize = isArraySeq(seqType) ? 0 : 1;
+    if (source->size() == 0)
+    {
+        size += writeEmptyContent().size();
+    }
+    else if (unitWidth() > 0 || seqWordSize(seqType) > 1)
+    {
+        size += fixedWidthContentSize(*source, quoteSize);
+    }
+    else
+    {
+        // the escape sequences and the words of the text seqs depend on every character, they are converted once
+        // into a sink that keeps nothing but the count
+        CountingSink counter;
+        encode(*source, counter, std::string(quoteSize, '"'), 0, source->size());
+        size += counter.size();
+    }
+
+    if (variable.addtextsegment)
     {
-        std::string currentItem = characters[i];
-        boost::algorithm::trim(currentItem);
+        size += writeTextSegmentHead().size() + source->size() + 3;
+    }
+    return size;
+}
 
-        std::string character;
-        if ((seq == "HEX" || seq == "OCT"))
+std::size_t CTextToCPP::fixedWidthContentSize(ByteSource &source, const std::size_t quoteSize) const
+{
+    const std::size_t wordSize = seqWordSize(seqType);
+    const std::size_t width = wordSize > 1 ? 2 * wordSize + 3 : unitWidth();
+    const std::size_t units = (source.size() + wordSize - 1) / wordSize;
+    const std::size_t signPerLine = std::max(parameter.signPerLine, 0);
+
+    // the last element of an array has no comma
+    const std::size_t lastWidth = isArraySeq(seqType) ? width - 1 : width;
+    const std::size_t perLine = std::max<std::size_t>(1, signPerLine / width);
+
+    // number of lines of a part between two line ends, a unit starts a new line if it does not fit behind the others
+    std::size_t lines = 0;
+    std::size_t lineStart = 0;
+    const auto endLine = [&](const std::size_t lineEnd)
+    {
+        const std::size_t count = lineEnd - lineStart;
+        if (count > 0 && (lineEnd < units || lastWidth == width))
         {
-            if (i > 0)
-            {
-                character = separator + currentItem;
-            }
-            else
-            {
-                character = currentItem;
-            }
+            lines += (count + perLine - 1) / perLine;
         }
-        else if (seq == "ESC" && (currentItem == newLineChar || currentItem == returnChar))
+        else if (count > 0)
         {
-            character = currentItem;
+            const std::size_t fullLines = (count - 1 + perLine - 1) / perLine;
+            const std::size_t onLastLine = count - 1 - (fullLines > 0 ? fullLines - 1 : 0) * perLine;
+            lines += fullLines + (fullLines == 0 || onLastLine * width + lastWidth > signPerLine ? 1 : 0);
         }
-        else
+        lineStart = lineEnd;
+    };
+
+    // a line ends behind the unit of a LF or a CR, in DOS mode behind the unit that follows a CR;
+    // the words of the packed seqs never end a line
+    if (wordSize == 1)
+    {
+        const char breakChar = newLineMode == NewLineMode::UNIX ? '\n' : '\r';
+        std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+        std::size_t position = 0;
+        std::size_t count;
+        bool afterReturn = false;
+        while ((count = source.read(buffer.data(), buffer.size())) > 0)
         {
-            character = (i < characters.size() - 1) ? currentItem + separator : currentItem;
+            const char *begin = buffer.data();
+            const char *end = begin + count;
+            const char *next = begin;
+            while (next < end)
+            {
+                if (afterReturn)
+                {
+                    while (next < end && *next == '\r')
+                    {
+                        next++;
+                    }
+                    if (next == end)
+                    {
+                        break;
+                    }
+                    afterReturn = false;
+                    next++;
+                    endLine(position + (next - begin));
+                    continue;
+                }
+
+                const char *found = static_cast<const char *>(std::memchr(next, breakChar, end - next));
+                if (found == nullptr)
+                {
+                    break;
+                }
+                next = found + 1;
+                if (newLineMode == NewLineMode::DOS)
+                {
+                    afterReturn = true;
+                }
+                else
+                {
+                    endLine(position + (next - begin));
+                }
+            }
+            position += count;
         }
+    }
+    endLine(units);
 
-        int length = character.length();
-        count += length;
+    // every line gets its quotes and the line continuation " \\\n"
+    const std::size_t characters = units > 0 ? (units - 1) * width + lastWidth : 0;
+    return characters + lines * (2 * quoteSize + 3);
+}
 
-        if (count > signPerLine)
-        {
-            result.push_back(line);
-            line = "";
-            count = length;
-        }
+void CTextToCPP::writeImplementation(OutputSink &sink)
+{
+    // the compiler reads the content from the binary file next to the source if it supports #embed,
+    // the RAWHEX elements are only the fallback
+    if (seqType == SeqType::EMBED)
+    {
+        copyToFile(*openContent(), embedFilePath());
+    }
 
-        line.append(character);
+    sink.write(writeDefinitionOpening());
+    writeContent(sink);
+    sink.write(writeDefinitionClosing());
+    writeTextSegment(sink);
+}
 
-        if ((nl == "DOS" && currentItem == returnChar))
-        {
-            dosNext = true;
-            continue;
-        }
+std::string CTextToCPP::writeDefinitionOpening() const
+{
+    std::string opening;
+    if (sharedContent)
+    {
+        // a const array has internal linkage in C++ unless it is defined extern, in C it only needs no static
+        const std::string linkage = !exportedContent ? "static " : (parameter.outputType == "cpp" ? "extern " : "");
+        opening = linkage + "const char " + variable.name + "_content[] = {\n";
+    }
+    else
+    {
+        opening = writeDefinitionHead() + " = {\n";
+    }
 
-        if ((nl == "UNIX" && currentItem == newLineChar) || (nl == "MAC" && currentItem == returnChar) || dosNext || (i == (characters.size() - 1)))
-        {
-            result.push_back(line);
-            line = "";
-            count = 0;
-            dosNext = false;
-        }
+    if (seqType == SeqType::EMBED)
+    {
+        // an empty file gives the same single element as the fallback
+        opening.append("#if defined(__has_embed)\n#embed \"" + embedFileName() + "\" if_empty(0)\n#else\n");
     }
+    return opening;
+}
 
-    return result;
+std::string CTextToCPP::writeDefinitionClosing() const
+{
+    std::string closing;
+    if (seqType == SeqType::EMBED)
+    {
+        // the empty line ends the line continuation of the last element
+        closing = "\n#endif\n";
+    }
+    closing.append("};\n");
+    if (sharedContent)
+    {
+        closing.append(writeDefinitionHead() + " = " + variable.name + "_content;\n");
+    }
+    return closing;
 }
 
-/**
- * @brief Function to generate content of header file.
- * @return declarationText Text to be declared in header file.
- */
-std::string CTextToCPP::writeDeclaration()
-{ // header stuff
-    /**
-     * @brief Holds the generated declaration code.
-     */
-    std::string declarationText;
+void CTextToCPP::writeContent(OutputSink &sink)
+{
+    std::string quotes = "\"";
+    if (isArraySeq(seqType))
+    {
+        quotes = "";
+    }
 
-    // Check Doxygentext
-    if (!variable.doxygen.empty())
+    // convert and wrap in one pass straight into the sink
+    const std::unique_ptr<ByteSource> source = openContent();
+
+    // RAW picks one delimiter for the whole content and cuts its literals by length, so it is never split into blocks
+    if (seqType != SeqType::RAW && seqWordSize(seqType) == 1 && parameter.parallelThreshold > 0 && source->size() >= parameter.parallelThreshold && ThreadPool::shared().size() > 1)
     {
-        declarationText.append("/** " + variable.doxygen);
-        if (variable.addtextpos)
+        encodeParallel(*source, sink, quotes);
+    }
+    else if (source->size() == 0)
+    {
+        sink.write(writeEmptyContent());
+    }
+    else
+    {
+        encode(*source, sink, quotes, 0, source->size());
+    }
+}
+
+void CTextToCPP::writeTextSegment(OutputSink &sink)
+{
+    if (variable.addtextsegment)
+    {
+        sink.write(writeTextSegmentHead());
+
+        const std::unique_ptr<ByteSource> source = openContent();
+
+        // copy the original text in chunks as well
+        std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+        std::size_t count;
+        while ((count = source->read(buffer.data(), buffer.size())) > 0)
         {
-            declarationText.append(" (aus Zeile" + std::to_string(variable.VariableLineNumber) + " ) ");
+            sink.write(buffer.data(), count);
         }
-        declarationText.append("*/\n");
+        sink.write("*/\n", 3);
     }
+}
 
-    declarationText.append("const char ");
-    if (variable.seq != "RAWHEX")
+std::string CTextToCPP::writeEmptyContent() const
+{
+    if (isArraySeq(seqType))
     {
-        declarationText.append("*const ");
+        // an array needs one element at least, the NAME_size constant stays 0
+        return "0\n";
     }
-    declarationText.append(variable.name);
+    // an empty initializer would be an array without the NUL
+    return parameter.arrayDefinitions ? "\"\"\n" : "";
+}
+
+std::string CTextToCPP::writeTextSegmentHead() const
+{
+    return "/*\nOriginaltext aus der Variablensektion '" + variable.name + "'\n\n";
+}
+
+std::size_t CTextToCPP::unitWidth() const
+{
+    return 0;
+}
+
+std::size_t CTextToCPP::findLineBreak(const std::string &data, const std::size_t from) const
+{
+    const char *begin = data.data();
+    const char *end = begin + data.size();
 
-    if (variable.seq == "RAWHEX")
+    if (newLineMode == NewLineMode::DOS)
     {
-        declarationText.append("[]");
+        if (unitWidth() == 0)
+        {
+            // the escaped CR LF pair ends the line, other units behind a CR may be words that go on
+            for (std::size_t pos = std::max<std::size_t>(from, 1); pos < data.size(); pos++)
+            {
+                const char *found = static_cast<const char *>(std::memchr(begin + pos, '\n', data.size() - pos));
+                if (found == nullptr)
+                {
+                    break;
+                }
+                pos = found - begin;
+                if (data[pos - 1] == '\r')
+                {
+                    return pos + 1;
+                }
+            }
+            return std::string::npos;
+        }
+
+        // the line ends behind the first character that follows a CR
+        std::size_t pos = from > 0 ? from - 1 : 0;
+        while (pos < data.size())
+        {
+            const char *found = static_cast<const char *>(std::memchr(begin + pos, '\r', data.size() - pos));
+            if (found == nullptr)
+            {
+                break;
+            }
+            while (found < end && *found == '\r')
+            {
+                found++;
+            }
+            if (found == end)
+            {
+                break;
+            }
+            pos = found - begin;
+            if (pos >= from)
+            {
+                return pos + 1;
+            }
+        }
+        return std::string::npos;
     }
-    declarationText.append(";\n");
 
-    return declarationText;
+    const char breakChar = newLineMode == NewLineMode::MAC ? '\r' : '\n';
+    if (from >= data.size())
+    {
+        return std::string::npos;
+    }
+    const char *found = static_cast<const char *>(std::memchr(begin + from, breakChar, data.size() - from));
+    return found == nullptr ? std::string::npos : found - begin + 1;
 }
 
-/**
- * @brief Function to generate text of the source file.
- * The text is to be converted and new lines are to be inserted.
- * @return Source text.
- */
-std::string CTextToCPP::writeImplementation()
-{ // source stuff
-    /**
-     * @brief Holds the generated source code.
-     */
-    std::string sourceText;
+std::size_t CTextToCPP::findLineStart(const std::string &data, const std::size_t from) const
+{
+    const std::size_t lineBreak = findLineBreak(data, from);
+    const std::size_t width = unitWidth();
+    if (lineBreak != std::string::npos || width == 0)
+    {
+        return lineBreak;
+    }
 
-    sourceText.append("const char ");
-    if (variable.seq != "RAWHEX")
+    // with units of the same width a line is wrapped after the same number of units, counted from the last line break
+    std::size_t lineStart = 0;
+    for (std::size_t pos = findLineBreak(data, 0); pos != std::string::npos && pos <= from; pos = findLineBreak(data, pos))
     {
-        sourceText.append("*const ");
+        lineStart = pos;
     }
 
-    sourceText.append(variable.name);
-    if (variable.seq == "RAWHEX")
+    const std::size_t perLine = std::max<std::size_t>(1, std::max(parameter.signPerLine, 0) / width);
+    std::size_t split = lineStart + (from - lineStart + perLine - 1) / perLine * perLine;
+
+    // behind a CR the next unit still belongs to the line in DOS mode
+    while (newLineMode == NewLineMode::DOS && split > 0 && split <= data.size() && data[split - 1] == '\r')
     {
-        sourceText.append("[]");
+        split += perLine;
     }
+    return split <= data.size() ? split : std::string::npos;
+}
+
+void CTextToCPP::encodeParallel(ByteSource &source, OutputSink &sink, const std::string &quotes)
+{
+    ThreadPool &pool = ThreadPool::shared();
+    const std::size_t total = source.size();
+    const std::size_t maxQueued = 2 * pool.size();
 
-    sourceText.append(" = {\n");
-    const std::string convertedContent = convert(variable.content, variable.VariableLineNumber, parameter.outputFilename, variable.nl);
-    const std::vector<std::string> adoptedContent = insertLineBreaks(parameter.signPerLine, convertedContent, variable.nl, variable.seq);
+    std::deque<std::future<std::string>> queued;
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::string pending;           // read but not yet converted, starts at the beginning of a line
+    std::size_t pendingOffset = 0; // position of pending in the content
+    bool sourceEnd = false;
 
-    for (std::string line : adoptedContent)
+    const auto submitBlock = [&](std::string block, const std::size_t offset)
+    {
+        queued.push_back(pool.submit([this, &quotes, total, offset, block = std::move(block)]()
+                                     {
+                                         std::string output;
+                                         StringSink blockSink(output);
+                                         StringSource blockSource(block);
+                                         encode(blockSource, blockSink, quotes, offset, total);
+                                         return output; }));
+    };
+    const auto writeBlocks = [&](const std::size_t keep)
     {
-        std::string quotes = "\"";
-        if (variable.seq == "RAWHEX")
+        while (queued.size() > keep)
         {
-            quotes = "";
+            sink.write(pool.wait(queued.front()));
+            queued.pop_front();
         }
-        sourceText.append(quotes + line + quotes + " \\\n");
-    }
-
-    sourceText.append("};\n");
+    };
 
-    if (variable.addtextsegment)
+    while (true)
     {
-        const std::string originalTextComment = "/*\nOriginaltext aus der Variablensektion '" + variable.name + "'\n\n" + variable.content + "*/\n";
-        sourceText.append(originalTextComment);
-    }
+        // a block ends at the first line start behind PARALLEL_BLOCK_SIZE, the same size behind it is searched for one
+        while (!sourceEnd && pending.size() < 2 * PARALLEL_BLOCK_SIZE)
+        {
+            const std::size_t count = source.read(buffer.data(), buffer.size());
+            pending.append(buffer.data(), count);
+            sourceEnd = count == 0;
+        }
 
-    return sourceText;
+        if (sourceEnd && pending.size() < 2 * PARALLEL_BLOCK_SIZE)
+        {
+            if (!pending.empty())
+            {
+                submitBlock(std::move(pending), pendingOffset);
+            }
+            writeBlocks(0);
+            return;
+        }
+
+        const std::size_t split = findLineStart(pending, PARALLEL_BLOCK_SIZE);
+        if (split == std::string::npos)
+        {
+            // no line start that is known without converting, e.g. a long line of words, convert the rest serially
+            writeBlocks(0);
+            PrefixedSource rest(pending, source, total - pendingOffset - pending.size());
+            encode(rest, sink, quotes, pendingOffset, total);
+            return;
+        }
+
+        submitBlock(pending.substr(0, split), pendingOffset);
+        pending.erase(0, split);
+        pendingOffset += split;
+        writeBlocks(maxQueued);
+    }
 }
 
 void CTextToCPP::addElement(CTextToCPP *element)
@@ -300,6 +683,7 @@ CTextToCPP::~CTextToCPP()
 {
 }
 
-CTextToCPP::CTextToCPP(const VariableStruct &variable, const ParamStruct &parameter) : parameter(parameter), variable(variable)
+CTextToCPP::CTextToCPP(const VariableStruct &variable, const ParamStruct &parameter)
+    : parameter(parameter), variable(variable), seqType(toSeqType(variable.seq)), newLineMode(toNewLineMode(variable.nl))
 {
 }
\ No newline at end of file
@@ -2,66 +2,209 @@
 #include <sstream>
 #include <fstream>
 #include <iomanip>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ESC_SIMD_X86 1
+#include <immintrin.h>
+#endif
 
 #include <CTextToEscSeq.h>
 
-std::string CTextToEscSeq::convert(std::string &inputString, const int &varLine, const std::string &inputFile, const std::string &nl)
+namespace
 {
-    std::stringstream stream;
-    unsigned int charPos = 0;
-    checkNewLine(inputString, nl);
-
-    // check each character in the input string and replace escape characters
-    for (unsigned char c : inputString)
+    /**
+     * @brief Signature of a scan kernel.
+     * Returns the offset of the first byte that needs an escape sequence or is a space, where the words for the
+     * line breaks end, or length if there is none. Non ASCII bytes are copied like any other character because
+     * the content was already checked with validateAscii().
+     */
+    using ScanFunction = std::size_t (*)(const unsigned char *data, std::size_t length);
 
+    // true for the 12 characters that get an escape sequence and for the space
+    inline bool isSpecial(const unsigned char c)
     {
-        checkASCII(c, varLine, charPos, inputFile);
+        return (c >= '\a' && c <= '\r') || c == '\e' || c == '\\' || c == '\'' || c == '\"' || c == '\?' || c == ' ';
+    }
 
+    // returns the two characters long escape sequence of a special ASCII character
+    const char *escapeSequence(const unsigned char c)
+    {
         switch (c)
         {
         case '\a':
-            stream << "\\a";
-            break;
+            return "\\a";
         case '\b':
-            stream << "\\b";
-            break;
+            return "\\b";
         case '\e':
-            stream << "\\e";
-            break;
+            return "\\e";
         case '\f':
-            stream << "\\f";
-            break;
+            return "\\f";
         case '\n':
-            stream << "\\n";
-            break;
+            return "\\n";
         case '\r':
-            stream << "\\r";
-            break;
+            return "\\r";
         case '\t':
-            stream << "\\t";
-            break;
+            return "\\t";
         case '\v':
-            stream << "\\v";
-            break;
+            return "\\v";
         case '\\':
-            stream << "\\\\";
-            break;
+            return "\\\\";
         case '\'':
-            stream << "\\'";
-            break;
+            return "\\'";
         case '\"':
-            stream << "\\\"";
-            break;
-        case '\?':
-            stream << "\\?";
-            break;
+            return "\\\"";
         default:
-            stream << c;
-            break;
+            return "\\?";
+        }
+    }
+
+    std::size_t scanScalar(const unsigned char *data, const std::size_t length)
+    {
+        std::size_t i = 0;
+        while (i < length && !isSpecial(data[i]))
+        {
+            i++;
+        }
+        return i;
+    }
+
+#ifdef ESC_SIMD_X86
+    __attribute__((target("sse2"))) std::size_t scanSSE2(const unsigned char *data, const std::size_t length)
+    {
+        // '\a' to '\r' are one continuous range, the other five are compared one by one
+        const __m128i rangeStart = _mm_set1_epi8('\a');
+        const __m128i rangeWidth = _mm_set1_epi8('\r' - '\a');
+        const __m128i escape = _mm_set1_epi8('\e');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i quote = _mm_set1_epi8('\'');
+        const __m128i doubleQuote = _mm_set1_epi8('\"');
+        const __m128i question = _mm_set1_epi8('\?');
+        const __m128i space = _mm_set1_epi8(' ');
+
+        std::size_t i = 0;
+        for (; i + 16 <= length; i += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            const __m128i shifted = _mm_sub_epi8(block, rangeStart);
+            __m128i hits = _mm_cmpeq_epi8(_mm_min_epu8(shifted, rangeWidth), shifted);
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, escape));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, backslash));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, quote));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, doubleQuote));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, question));
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, space));
+
+            const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(hits));
+            if (mask != 0)
+            {
+                return i + __builtin_ctz(mask);
+            }
         }
-        charPos++;
+        return i + scanScalar(data + i, length - i);
     }
-    return stream.str();
+
+    __attribute__((target("avx2"))) std::size_t scanAVX2(const unsigned char *data, const std::size_t length)
+    {
+        const __m256i rangeStart = _mm256_set1_epi8('\a');
+        const __m256i rangeWidth = _mm256_set1_epi8('\r' - '\a');
+        const __m256i escape = _mm256_set1_epi8('\e');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i quote = _mm256_set1_epi8('\'');
+        const __m256i doubleQuote = _mm256_set1_epi8('\"');
+        const __m256i question = _mm256_set1_epi8('\?');
+        const __m256i space = _mm256_set1_epi8(' ');
+
+        std::size_t i = 0;
+        for (; i + 32 <= length; i += 32)
+        {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            const __m256i shifted = _mm256_sub_epi8(block, rangeStart);
+            __m256i hits = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, rangeWidth), shifted);
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, escape));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, backslash));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, quote));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, doubleQuote));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, question));
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, space));
+
+            const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(hits));
+            if (mask != 0)
+            {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + scanSSE2(data + i, length - i);
+    }
+#endif
+
+    // picks the widest kernel the running CPU supports
+    ScanFunction selectScanFunction()
+    {
+#ifdef ESC_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return scanAVX2;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return scanSSE2;
+        }
+#endif
+        return scanScalar;
+    }
+}
+
+template <typename Emitter>
+void CTextToEscSeq::encodeLines(ByteSource &source, Emitter &emitter)
+{
+    static const ScanFunction scan = selectScanFunction();
+
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::size_t length;
+
+    // a word ends behind each space, new line characters are words of their own
+    // words can go on in the next chunk, the emitter only closes them at a space or a new line
+    while ((length = source.read(buffer.data(), buffer.size())) > 0)
+    {
+        const unsigned char *data = reinterpret_cast<const unsigned char *>(buffer.data());
+        std::size_t pos = 0;
+        while (pos < length)
+        {
+            const std::size_t next = pos + scan(data + pos, length - pos);
+            emitter.append(buffer.data() + pos, next - pos);
+            if (next == length)
+            {
+                break;
+            }
+
+            const unsigned char c = data[next];
+            if (c == ' ')
+            {
+                emitter.append(" ", 1);
+                emitter.endUnit();
+            }
+            else if (c == '\n' || c == '\r')
+            {
+                emitter.endUnit();
+                emitter.unit(escapeSequence(c), 2, c);
+            }
+            else
+            {
+                emitter.append(escapeSequence(c), 2);
+            }
+            pos = next + 1;
+        }
+    }
+    emitter.endUnit();
+}
+
+void CTextToEscSeq::encode(ByteSource &source, OutputSink &sink, const std::string &quotes,
+                           const std::size_t, const std::size_t)
+{
+    withLineEmitter(sink, quotes, [&](auto &emitter)
+                    { encodeLines(source, emitter); });
 }
 
 // constructor to initialize an instance of the CTextToEscSeq class
@@ -1,27 +1,36 @@
 #include <iostream>
-#include <sstream>
-#include <iomanip>
+#include <vector>
 
+#include <SequenceTables.h>
 #include <CTextToHexSeq.h>
 
-std::string CTextToHexSeq::convert(std::string &inputString, const int &varLine, const std::string &inputFile, const std::string &nl)
-
+template <typename Emitter>
+void CTextToHexSeq::encodeLines(ByteSource &source, Emitter &emitter)
 {
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::size_t length;
 
-    std::stringstream stream;
-    stream << std::hex << std::setfill('0');
-    unsigned int charPos = 0;
-
-    checkNewLine(inputString, nl);
-
-    for (unsigned char c : inputString)
+    // every fragment is a unit of its own
+    while ((length = source.read(buffer.data(), buffer.size())) > 0)
     {
-        checkASCII(c, varLine, charPos, inputFile);
-
-        stream << "\\x" << std::setw(2) << static_cast<int>(c);
-        charPos++;
+        for (std::size_t i = 0; i < length; i++)
+        {
+            const unsigned char c = static_cast<unsigned char>(buffer[i]);
+            emitter.unit(HEX_TABLE[c].data(), HEX_FRAGMENT_WIDTH, c);
+        }
     }
-    return stream.str();
+}
+
+void CTextToHexSeq::encode(ByteSource &source, OutputSink &sink, const std::string &quotes,
+                           const std::size_t, const std::size_t)
+{
+    withLineEmitter(sink, quotes, [&](auto &emitter)
+                    { encodeLines(source, emitter); });
+}
+
+std::size_t CTextToHexSeq::unitWidth() const
+{
+    return HEX_FRAGMENT_WIDTH;
 }
 
 // constructor to initialize an instance of the CTextToEscSeq class
@@ -1,25 +1,36 @@
 #include <iostream>
-#include <sstream>
-#include <iomanip>
+#include <vector>
 
+#include <SequenceTables.h>
 #include <CTextToOctSeq.h>
 
-std::string CTextToOctSeq::convert(std::string &inputString, const int &varLine, const std::string &inputFile, const std::string &nl)
+template <typename Emitter>
+void CTextToOctSeq::encodeLines(ByteSource &source, Emitter &emitter)
 {
-    std::stringstream stream;
-    stream << std::oct << std::setfill('0');
-    unsigned int charPos = 0;
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::size_t length;
 
-    checkNewLine(inputString, nl);
-
-    for (unsigned char c : inputString)
+    // every fragment is a unit of its own
+    while ((length = source.read(buffer.data(), buffer.size())) > 0)
     {
-        checkASCII(c, varLine, charPos, inputFile);
-
-        stream << "\\" << std::setw(3) << static_cast<int>(c);
-        charPos++;
+        for (std::size_t i = 0; i < length; i++)
+        {
+            const unsigned char c = static_cast<unsigned char>(buffer[i]);
+            emitter.unit(OCT_TABLE[c].data(), OCT_FRAGMENT_WIDTH, c);
+        }
     }
-    return stream.str();
+}
+
+void CTextToOctSeq::encode(ByteSource &source, OutputSink &sink, const std::string &quotes,
+                           const std::size_t, const std::size_t)
+{
+    withLineEmitter(sink, quotes, [&](auto &emitter)
+                    { encodeLines(source, emitter); });
+}
+
+std::size_t CTextToOctSeq::unitWidth() const
+{
+    return OCT_FRAGMENT_WIDTH;
 }
 
 // constructor to initialize an instance of the CTextToOctSeq class
@@ -31,4 +42,4 @@ CTextToOctSeq::CTextToOctSeq(const VariableStruct &variable, const ParamStruct &
 // destructor for the CTextToOctSeq class
 CTextToOctSeq::~CTextToOctSeq()
 {
-}
\ No newline at end of file
+}
@@ -1,35 +1,102 @@
 #include <iostream>
-#include <sstream>
-#include <iomanip>
+#include <vector>
+#include <array>
+#include <cstring>
 
+#include <SequenceTables.h>
 #include <CTextToRawHexSeq.h>
 
-std::string CTextToRawHexSeq::convert(std::string &inputString, const int &varLine, const std::string &inputFile, const std::string &nl)
+template <typename Emitter>
+void CTextToRawHexSeq::encodeLines(ByteSource &source, Emitter &emitter, const std::size_t offset, const std::size_t total)
 {
-    std::stringstream stream;
-    stream << std::hex << std::setfill('0');
-    unsigned int charPos = 0;
-    checkNewLine(inputString, nl);
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::size_t position = offset;
+    std::size_t length;
 
-    bool firstElement = true;
+    // each element is "0xNN," without the space, the last one without the comma
+    while ((length = source.read(buffer.data(), buffer.size())) > 0)
+    {
+        for (std::size_t i = 0; i < length; i++)
+        {
+            const unsigned char c = static_cast<unsigned char>(buffer[i]);
+            emitter.unit(RAWHEX_TABLE[c].data(), (position + i + 1 < total) ? RAWHEX_FRAGMENT_WIDTH - 1 : RAWHEX_FRAGMENT_WIDTH - 2, c);
+        }
+        position += length;
+    }
+}
+
+template <std::size_t WordSize, typename Emitter>
+void CTextToRawHexSeq::encodeWords(ByteSource &source, Emitter &emitter, const std::size_t total)
+{
+    // "0x", two digits per byte with the last byte first and the comma
+    std::array<char, 2 * WordSize + 3> element;
+    element[0] = '0';
+    element[1] = 'x';
+    element[element.size() - 1] = ',';
 
-    for (unsigned char c : inputString)
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::size_t position = 0;
+    std::size_t filled = 0;
+    std::size_t length;
+    const auto emitWord = [&]()
     {
-        checkASCII(c, varLine, charPos, inputFile);
+        emitter.unit(element.data(), position < total ? element.size() : element.size() - 1, 0);
+        filled = 0;
+    };
 
-        if (!firstElement)
-            stream << ", "; // Add a comma and space before elements except for the first one
-        else
-            firstElement = false;
+    while ((length = source.read(buffer.data(), buffer.size())) > 0)
+    {
+        for (std::size_t i = 0; i < length; i++)
+        {
+            const unsigned char c = static_cast<unsigned char>(buffer[i]);
+            std::memcpy(&element[2 + 2 * (WordSize - 1 - filled)], HEX_TABLE[c].data() + 2, 2);
+            filled++;
+            position++;
+            if (filled == WordSize)
+            {
+                emitWord();
+            }
+        }
+    }
 
-        stream << "0x" << std::setw(2) << static_cast<int>(c);
-        charPos++;
+    if (filled > 0)
+    {
+        for (std::size_t i = filled; i < WordSize; i++)
+        {
+            std::memcpy(&element[2 + 2 * (WordSize - 1 - i)], "00", 2);
+        }
+        emitWord();
     }
-    return stream.str();
+}
+
+void CTextToRawHexSeq::encode(ByteSource &source, OutputSink &sink, const std::string &quotes,
+                              const std::size_t offset, const std::size_t total)
+{
+    // the packed arrays are never split into blocks, so they always start at the beginning of the content
+    withLineEmitter(sink, quotes, [&](auto &emitter)
+                    {
+                        if (wordSize == 8)
+                        {
+                            encodeWords<8>(source, emitter, total);
+                        }
+                        else if (wordSize == 4)
+                        {
+                            encodeWords<4>(source, emitter, total);
+                        }
+                        else
+                        {
+                            encodeLines(source, emitter, offset, total);
+                        } });
+}
+
+std::size_t CTextToRawHexSeq::unitWidth() const
+{
+    return RAWHEX_FRAGMENT_WIDTH - 1;
 }
 
 // constructor to initialize an instance of the CTextToRawHexSeq class
-CTextToRawHexSeq::CTextToRawHexSeq(const VariableStruct &variable, const ParamStruct &parameter) : CTextToCPP(variable, parameter)
+CTextToRawHexSeq::CTextToRawHexSeq(const VariableStruct &variable, const ParamStruct &parameter)
+    : CTextToCPP(variable, parameter), wordSize(seqWordSize(toSeqType(variable.seq)))
 {
     // constructor implementation
 }
@@ -37,4 +104,4 @@ CTextToRawHexSeq::CTextToRawHexSeq(const VariableStruct &variable, const ParamSt
 // destructor for the CTextToRawHexSeq class
 CTextToRawHexSeq::~CTextToRawHexSeq()
 {
-}
\ No newline at end of file
+}
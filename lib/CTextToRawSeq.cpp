@@ -0,0 +1,187 @@
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <unordered_set>
+
+#include <SequenceTables.h>
+#include <CTextToRawSeq.h>
+
+namespace
+{
+    // the longest delimiter the standard allows
+    constexpr std::size_t MAX_DELIMITER = 16;
+
+    // true for the characters that are written as they are inside a raw string literal
+    inline bool isPlain(const unsigned char c)
+    {
+        return c >= ' ' ? c != 0x7F : (c == '\n' || c == '\t');
+    }
+
+    // returns the next candidate delimiter, "", "a" ... "z", "aa", "ab" ...
+    void nextCandidate(std::string &candidate)
+    {
+        for (std::size_t i = candidate.size(); i-- > 0;)
+        {
+            if (candidate[i] != 'z')
+            {
+                candidate[i]++;
+                return;
+            }
+            candidate[i] = 'a';
+        }
+        candidate.insert(candidate.begin(), 'a');
+    }
+}
+
+std::string CTextToRawSeq::findDelimiter(ByteSource &source)
+{
+    // only delimiters of lower case letters are tried, so only those have to be collected
+    std::unordered_set<std::string> used;
+    std::string found;
+    bool collecting = false;
+
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::size_t length;
+    while ((length = source.read(buffer.data(), buffer.size())) > 0)
+    {
+        const char *data = buffer.data();
+        const char *end = data + length;
+        while (data < end)
+        {
+            if (!collecting)
+            {
+                // jump to the next ')' that could start a closing sequence
+                data = static_cast<const char *>(std::memchr(data, ')', end - data));
+                if (data == nullptr)
+                {
+                    break;
+                }
+            }
+
+            const char c = *data++;
+            if (c == ')')
+            {
+                found.clear();
+                collecting = true;
+            }
+            else if (c == '\"')
+            {
+                used.insert(found);
+                collecting = false;
+            }
+            else if (c >= 'a' && c <= 'z' && found.size() < MAX_DELIMITER)
+            {
+                found.push_back(c);
+            }
+            else
+            {
+                collecting = false;
+            }
+        }
+    }
+
+    std::string candidate;
+    while (used.count(candidate) > 0)
+    {
+        nextCandidate(candidate);
+    }
+    return candidate;
+}
+
+void CTextToRawSeq::encode(ByteSource &source, OutputSink &sink, const std::string &,
+                           const std::size_t, const std::size_t)
+{
+    const std::string delimiter = findDelimiter(source);
+    source.rewind();
+
+    const std::string open = "R\"" + delimiter + "(";
+    const std::string close = ")" + delimiter + "\"\n";
+
+    // the content goes into raw literals, the control characters into ordinary literals between them
+    enum class Literal
+    {
+        NONE,
+        RAW,
+        ESCAPED
+    };
+    Literal literal = Literal::NONE;
+    std::size_t pieceLength = 0;
+    const auto endLiteral = [&]()
+    {
+        if (literal == Literal::RAW)
+        {
+            sink.write(close);
+        }
+        else if (literal == Literal::ESCAPED)
+        {
+            sink.write("\"\n", 2);
+        }
+        literal = Literal::NONE;
+    };
+
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::size_t length;
+    while ((length = source.read(buffer.data(), buffer.size())) > 0)
+    {
+        std::size_t pos = 0;
+        while (pos < length)
+        {
+            std::size_t next = pos;
+            while (next < length && isPlain(static_cast<unsigned char>(buffer[next])))
+            {
+                next++;
+            }
+
+            // the plain run, split where a literal is full
+            while (pos < next)
+            {
+                if (literal != Literal::RAW)
+                {
+                    endLiteral();
+                    sink.write(open);
+                    literal = Literal::RAW;
+                    pieceLength = 0;
+                }
+                const std::size_t count = std::min(next - pos, RAW_PIECE_SIZE - pieceLength);
+                sink.write(buffer.data() + pos, count);
+                pieceLength += count;
+                pos += count;
+                if (pieceLength == RAW_PIECE_SIZE)
+                {
+                    endLiteral();
+                }
+            }
+
+            if (pos < length)
+            {
+                const unsigned char c = static_cast<unsigned char>(buffer[pos]);
+                if (literal != Literal::ESCAPED)
+                {
+                    endLiteral();
+                    sink.write("\"", 1);
+                    literal = Literal::ESCAPED;
+                }
+                if (c == '\r')
+                {
+                    sink.write("\\r", 2);
+                }
+                else
+                {
+                    sink.write(OCT_TABLE[c].data(), OCT_FRAGMENT_WIDTH);
+                }
+                pos++;
+            }
+        }
+    }
+    endLiteral();
+}
+
+// constructor to initialize an instance of the CTextToRawSeq class
+CTextToRawSeq::CTextToRawSeq(const VariableStruct &variable, const ParamStruct &parameter) : CTextToCPP(variable, parameter)
+{
+}
+
+// destructor for the CTextToRawSeq class
+CTextToRawSeq::~CTextToRawSeq()
+{
+}
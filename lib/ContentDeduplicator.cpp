@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ContentDeduplicator.h>
+
+namespace
+{
+    // number of last bytes kept of every content to rule out most suffix candidates without reading them again
+    constexpr std::size_t TAIL_SIZE = 32;
+
+    /**
+     * @brief Size, hash and last bytes of a content.
+     */
+    struct Fingerprint
+    {
+        std::size_t size = 0;
+        std::uint64_t hash = 14695981039346656037ull; // FNV-1a offset basis
+        std::string tail;
+    };
+
+    Fingerprint fingerprint(ByteSource &source)
+    {
+        Fingerprint print;
+        print.size = source.size();
+
+        std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+        std::size_t length;
+        source.rewind();
+        while ((length = source.read(buffer.data(), buffer.size())) > 0)
+        {
+            for (std::size_t i = 0; i < length; i++)
+            {
+                print.hash = (print.hash ^ static_cast<unsigned char>(buffer[i])) * 1099511628211ull;
+            }
+            // the tail can start in the chunk before
+            print.tail.append(buffer.data() + length - std::min(length, TAIL_SIZE), std::min(length, TAIL_SIZE));
+            if (print.tail.size() > TAIL_SIZE)
+            {
+                print.tail.erase(0, print.tail.size() - TAIL_SIZE);
+            }
+        }
+        return print;
+    }
+
+    // reads until length bytes are read or the source ends
+    std::size_t readFully(ByteSource &source, char *buffer, const std::size_t length)
+    {
+        std::size_t total = 0;
+        std::size_t count;
+        while (total < length && (count = source.read(buffer + total, length - total)) > 0)
+        {
+            total += count;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Size and hash of a content, the key of the equal contents.
+     */
+    struct SizeHash
+    {
+        std::size_t size;
+        std::uint64_t hash;
+
+        bool operator==(const SizeHash &other) const
+        {
+            return size == other.size && hash == other.hash;
+        }
+    };
+
+    struct SizeHashHasher
+    {
+        std::size_t operator()(const SizeHash &key) const
+        {
+            return static_cast<std::size_t>(key.hash ^ (key.size * 0x9e3779b97f4a7c15ull));
+        }
+    };
+}
+
+bool endsWith(ByteSource &content, ByteSource &suffix)
+{
+    if (suffix.size() > content.size())
+    {
+        return false;
+    }
+    content.rewind();
+    suffix.rewind();
+
+    std::vector<char> contentBuffer(SOURCE_CHUNK_SIZE);
+    std::vector<char> suffixBuffer(SOURCE_CHUNK_SIZE);
+    std::size_t skip = content.size() - suffix.size();
+    while (skip > 0)
+    {
+        const std::size_t length = content.read(contentBuffer.data(), std::min(skip, contentBuffer.size()));
+        if (length == 0)
+        {
+            return false;
+        }
+        skip -= length;
+    }
+
+    std::size_t length;
+    while ((length = suffix.read(suffixBuffer.data(), suffixBuffer.size())) > 0)
+    {
+        if (readFully(content, contentBuffer.data(), length) != length ||
+            std::memcmp(contentBuffer.data(), suffixBuffer.data(), length) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<ContentAlias> findContentAliases(const std::vector<std::unique_ptr<ByteSource>> &sources)
+{
+    std::vector<ContentAlias> aliases(sources.size());
+    std::vector<Fingerprint> prints(sources.size());
+    std::vector<std::size_t> order;
+    for (std::size_t i = 0; i < sources.size(); i++)
+    {
+        aliases[i] = {i, 0};
+        if (sources[i] != nullptr && sources[i]->size() > 0)
+        {
+            prints[i] = fingerprint(*sources[i]);
+            order.push_back(i);
+        }
+    }
+
+    // the longest contents come first, so every content that fits into another one fits into one of the roots
+    std::stable_sort(order.begin(), order.end(), [&](const std::size_t a, const std::size_t b)
+                     { return prints[a].size > prints[b].size; });
+
+    // The roots are found by index instead of being compared one by one: equal contents by size and hash, the roots
+    // that end with a content longer than the tail by their whole tail, and the ones that end with a shorter content,
+    // which is its own tail, by every end of their tail. The first root of an end is the longest one.
+    std::unordered_map<SizeHash, std::vector<std::size_t>, SizeHashHasher> equalRoots;
+    std::unordered_map<std::string, std::vector<std::size_t>> tailRoots;
+    std::unordered_map<std::string, std::size_t> shortRoots;
+
+    // the sources are rewound after a comparison, so at most two files are open at a time
+    const auto fits = [&](const std::size_t root, const std::size_t index)
+    {
+        const bool result = endsWith(*sources[root], *sources[index]);
+        sources[root]->rewind();
+        sources[index]->rewind();
+        return result;
+    };
+
+    for (const std::size_t index : order)
+    {
+        const Fingerprint &print = prints[index];
+        std::size_t target = index;
+
+        const auto equal = equalRoots.find({print.size, print.hash});
+        if (equal != equalRoots.end())
+        {
+            for (const std::size_t root : equal->second)
+            {
+                if (fits(root, index))
+                {
+                    target = root;
+                    break;
+                }
+            }
+        }
+        if (target == index && print.size <= TAIL_SIZE)
+        {
+            const auto shortRoot = shortRoots.find(print.tail);
+            if (shortRoot != shortRoots.end())
+            {
+                target = shortRoot->second;
+            }
+        }
+        else if (target == index)
+        {
+            const auto tailRoot = tailRoots.find(print.tail);
+            if (tailRoot != tailRoots.end())
+            {
+                for (const std::size_t root : tailRoot->second)
+                {
+                    if (prints[root].size > print.size && fits(root, index))
+                    {
+                        target = root;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (target != index)
+        {
+            aliases[index] = {target, prints[target].size - print.size};
+            continue;
+        }
+        equalRoots[{print.size, print.hash}].push_back(index);
+        if (print.tail.size() == TAIL_SIZE)
+        {
+            tailRoots[print.tail].push_back(index);
+        }
+        for (std::size_t length = 1; length <= print.tail.size(); length++)
+        {
+            shortRoots.emplace(print.tail.substr(print.tail.size() - length), index);
+        }
+    }
+
+    for (const std::unique_ptr<ByteSource> &source : sources)
+    {
+        if (source != nullptr)
+        {
+            source->rewind();
+        }
+    }
+    return aliases;
+}
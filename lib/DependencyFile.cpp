@@ -0,0 +1,36 @@
+#include <DependencyFile.h>
+
+std::string escapeMakePath(const std::string &path)
+{
+    std::string escaped;
+    escaped.reserve(path.size());
+    for (const char c : path)
+    {
+        if (c == ' ' || c == '#')
+        {
+            escaped.push_back('\\');
+        }
+        else if (c == '$')
+        {
+            escaped.push_back('$');
+        }
+        escaped.push_back(c);
+    }
+    return escaped;
+}
+
+std::string writeMakeRule(const std::vector<std::string> &targets, const std::vector<std::string> &prerequisites)
+{
+    std::string rule;
+    for (std::size_t i = 0; i < targets.size(); i++)
+    {
+        rule.append((i == 0 ? "" : " \\\n  ") + escapeMakePath(targets[i]));
+    }
+    rule.append(":");
+    for (const std::string &prerequisite : prerequisites)
+    {
+        rule.append(" \\\n  " + escapeMakePath(prerequisite));
+    }
+    rule.append("\n");
+    return rule;
+}
@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <cstdint>
+
+#include <ElfObjectWriter.h>
+
+namespace
+{
+    // Values of the ELF specification that are used here
+    constexpr std::uint16_t ET_REL = 1;
+#if defined(__aarch64__) || defined(_M_ARM64)
+    constexpr std::uint16_t MACHINE = 183;         // EM_AARCH64
+    constexpr std::uint32_t POINTER_RELOCATION = 257; // R_AARCH64_ABS64
+#else
+    constexpr std::uint16_t MACHINE = 62;          // EM_X86_64
+    constexpr std::uint32_t POINTER_RELOCATION = 1; // R_X86_64_64
+#endif
+
+    constexpr std::uint32_t SHT_PROGBITS = 1;
+    constexpr std::uint32_t SHT_SYMTAB = 2;
+    constexpr std::uint32_t SHT_STRTAB = 3;
+    constexpr std::uint32_t SHT_RELA = 4;
+    constexpr std::uint64_t SHF_WRITE = 0x1;
+    constexpr std::uint64_t SHF_ALLOC = 0x2;
+    constexpr std::uint64_t SHF_INFO_LINK = 0x40;
+    constexpr unsigned char STT_OBJECT_GLOBAL = 0x11; // STB_GLOBAL << 4 | STT_OBJECT
+    constexpr unsigned char STT_SECTION_LOCAL = 0x03; // STB_LOCAL << 4 | STT_SECTION
+
+    constexpr std::size_t HEADER_SIZE = 64;
+    constexpr std::size_t SECTION_HEADER_SIZE = 64;
+    constexpr std::size_t SYMBOL_SIZE = 24;
+    constexpr std::size_t RELOCATION_SIZE = 24;
+    constexpr std::size_t POINTER_SIZE = 8;
+
+    /**
+     * @brief Indices of the sections in the order they are written.
+     */
+    enum Section : std::uint16_t
+    {
+        NULL_SECTION,
+        RODATA,
+        DATA_REL_RO,
+        RELA_DATA_REL_RO,
+        SYMTAB,
+        STRTAB,
+        NOTE_GNU_STACK,
+        SHSTRTAB,
+        SECTION_COUNT
+    };
+
+    /**
+     * @brief Appends a value as little endian field of the given size.
+     */
+    void put(std::string &out, const std::uint64_t value, const std::size_t bytes)
+    {
+        for (std::size_t i = 0; i < bytes; i++)
+        {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    /**
+     * @brief Rounds a position up to a multiple of alignment.
+     */
+    std::size_t alignTo(const std::size_t position, const std::size_t alignment)
+    {
+        return (position + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @brief Appends a name to a string table and returns its offset.
+     */
+    std::uint32_t addName(std::string &table, const std::string &name)
+    {
+        const std::uint32_t offset = static_cast<std::uint32_t>(table.size());
+        table.append(name);
+        table.push_back('\0');
+        return offset;
+    }
+
+    /**
+     * @brief Writes NUL bytes until the sink is at position target.
+     */
+    void pad(OutputSink &sink, std::size_t &position, const std::size_t target)
+    {
+        static const char zeros[16] = {};
+        while (position < target)
+        {
+            const std::size_t count = std::min(target - position, sizeof(zeros));
+            sink.write(zeros, count);
+            position += count;
+        }
+    }
+}
+
+void ElfObjectWriter::addString(const std::string &symbol, std::unique_ptr<ByteSource> content)
+{
+    entries.push_back({symbol, std::move(content), true, true, 1, "", 0});
+}
+
+void ElfObjectWriter::addStringArray(const std::string &symbol, std::unique_ptr<ByteSource> content)
+{
+    entries.push_back({symbol, std::move(content), true, false, 1, "", 0});
+}
+
+void ElfObjectWriter::addStringAlias(const std::string &symbol, const std::string &target, const std::size_t offset)
+{
+    entries.push_back({symbol, nullptr, true, true, 1, target, offset});
+}
+
+void ElfObjectWriter::addArray(const std::string &symbol, std::unique_ptr<ByteSource> content, const std::size_t alignment)
+{
+    entries.push_back({symbol, std::move(content), false, false, alignment, "", 0});
+}
+
+std::size_t ElfObjectWriter::write(OutputSink &sink)
+{
+    // Everything except the contents is small, so the tables are built first and the layout follows from their sizes
+    std::string shstrtab(1, '\0');
+    std::uint32_t sectionNames[SECTION_COUNT] = {};
+    sectionNames[RODATA] = addName(shstrtab, ".rodata");
+    sectionNames[DATA_REL_RO] = addName(shstrtab, ".data.rel.ro");
+    sectionNames[RELA_DATA_REL_RO] = addName(shstrtab, ".rela.data.rel.ro");
+    sectionNames[SYMTAB] = addName(shstrtab, ".symtab");
+    sectionNames[STRTAB] = addName(shstrtab, ".strtab");
+    sectionNames[NOTE_GNU_STACK] = addName(shstrtab, ".note.GNU-stack");
+    sectionNames[SHSTRTAB] = addName(shstrtab, ".shstrtab");
+
+    // the first local symbol is the null symbol, the second the .rodata section the pointers are relocated against
+    std::string strtab(1, '\0');
+    std::string symtab;
+    put(symtab, 0, SYMBOL_SIZE);
+    put(symtab, 0, 4);
+    symtab.push_back(static_cast<char>(STT_SECTION_LOCAL));
+    symtab.push_back('\0');
+    put(symtab, RODATA, 2);
+    put(symtab, 0, 8);
+    put(symtab, 0, 8);
+    const std::uint32_t sectionSymbol = 1;
+    const std::uint32_t firstGlobal = 2;
+
+    // the contents are placed first, so an alias can point into a text that comes behind it
+    std::size_t rodataSize = 0;
+    std::vector<std::size_t> positions(entries.size(), 0);
+    std::map<std::string, std::size_t> textPositions;
+    for (std::size_t i = 0; i < entries.size(); i++)
+    {
+        const Entry &entry = entries[i];
+        if (entry.content == nullptr)
+        {
+            continue;
+        }
+        rodataSize = alignTo(rodataSize, entry.alignment);
+        positions[i] = rodataSize;
+        textPositions[entry.symbol] = rodataSize;
+        rodataSize += alignTo(entry.content->size() + (entry.isString ? 1 : 0), entry.alignment);
+    }
+
+    std::string relocations;
+    std::size_t pointerCount = 0;
+    for (std::size_t i = 0; i < entries.size(); i++)
+    {
+        const Entry &entry = entries[i];
+        const std::size_t position = entry.content == nullptr ? textPositions.at(entry.target) + entry.targetOffset : positions[i];
+
+        put(symtab, addName(strtab, entry.symbol), 4);
+        symtab.push_back(static_cast<char>(STT_OBJECT_GLOBAL));
+        symtab.push_back('\0');
+        if (entry.isPointer)
+        {
+            put(symtab, DATA_REL_RO, 2);
+            put(symtab, pointerCount * POINTER_SIZE, 8);
+            put(symtab, POINTER_SIZE, 8);
+
+            put(relocations, pointerCount * POINTER_SIZE, 8);
+            put(relocations, static_cast<std::uint64_t>(sectionSymbol) << 32 | POINTER_RELOCATION, 8);
+            put(relocations, position, 8);
+            pointerCount++;
+        }
+        else
+        {
+            put(symtab, RODATA, 2);
+            put(symtab, position, 8);
+            put(symtab, alignTo(entry.content->size() + (entry.isString ? 1 : 0), entry.alignment), 8);
+        }
+    }
+
+    const std::size_t rodataOffset = HEADER_SIZE;
+    const std::size_t dataOffset = alignTo(rodataOffset + rodataSize, 8);
+    const std::size_t dataSize = pointerCount * POINTER_SIZE;
+    const std::size_t relocationOffset = dataOffset + dataSize;
+    const std::size_t symtabOffset = relocationOffset + relocations.size();
+    const std::size_t strtabOffset = symtabOffset + symtab.size();
+    const std::size_t shstrtabOffset = strtabOffset + strtab.size();
+    const std::size_t sectionHeaderOffset = alignTo(shstrtabOffset + shstrtab.size(), 8);
+
+    // ELF header
+    std::string header;
+    header.append("\x7f"
+                  "ELF",
+                  4);
+    header.push_back(2); // 64 bit
+    header.push_back(1); // little endian
+    header.push_back(1); // current version
+    put(header, 0, 9);   // System V ABI and padding
+    put(header, ET_REL, 2);
+    put(header, MACHINE, 2);
+    put(header, 1, 4);
+    put(header, 0, 8); // entry
+    put(header, 0, 8); // program headers
+    put(header, sectionHeaderOffset, 8);
+    put(header, 0, 4); // flags
+    put(header, HEADER_SIZE, 2);
+    put(header, 0, 2);
+    put(header, 0, 2);
+    put(header, SECTION_HEADER_SIZE, 2);
+    put(header, SECTION_COUNT, 2);
+    put(header, SHSTRTAB, 2);
+
+    std::size_t position = 0;
+    sink.write(header);
+    position += header.size();
+
+    // .rodata, the contents are copied in chunks
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    for (const Entry &entry : entries)
+    {
+        if (entry.content == nullptr)
+        {
+            continue;
+        }
+        pad(sink, position, alignTo(position, entry.alignment));
+        entry.content->rewind();
+        std::size_t count;
+        while ((count = entry.content->read(buffer.data(), buffer.size())) > 0)
+        {
+            sink.write(buffer.data(), count);
+            position += count;
+        }
+        if (entry.isString)
+        {
+            sink.write("\0", 1);
+            position++;
+        }
+        pad(sink, position, alignTo(position, entry.alignment));
+    }
+
+    // .data.rel.ro holds the pointers, their value comes from the addend of the relocation
+    pad(sink, position, dataOffset + dataSize);
+
+    sink.write(relocations);
+    sink.write(symtab);
+    sink.write(strtab);
+    sink.write(shstrtab);
+    position += relocations.size() + symtab.size() + strtab.size() + shstrtab.size();
+    pad(sink, position, sectionHeaderOffset);
+
+    // section headers
+    std::string sections;
+    const auto addSection = [&](const std::uint32_t name, const std::uint32_t type, const std::uint64_t flags,
+                                const std::size_t offset, const std::size_t size, const std::uint32_t link,
+                                const std::uint32_t info, const std::size_t alignment, const std::size_t entrySize)
+    {
+        put(sections, name, 4);
+        put(sections, type, 4);
+        put(sections, flags, 8);
+        put(sections, 0, 8); // address
+        put(sections, offset, 8);
+        put(sections, size, 8);
+        put(sections, link, 4);
+        put(sections, info, 4);
+        put(sections, alignment, 8);
+        put(sections, entrySize, 8);
+    };
+    addSection(0, 0, 0, 0, 0, 0, 0, 0, 0);
+    addSection(sectionNames[RODATA], SHT_PROGBITS, SHF_ALLOC, rodataOffset, rodataSize, 0, 0, 16, 0);
+    addSection(sectionNames[DATA_REL_RO], SHT_PROGBITS, SHF_ALLOC | SHF_WRITE, dataOffset, dataSize, 0, 0, 8, 0);
+    addSection(sectionNames[RELA_DATA_REL_RO], SHT_RELA, SHF_INFO_LINK, relocationOffset, relocations.size(), SYMTAB, DATA_REL_RO, 8, RELOCATION_SIZE);
+    addSection(sectionNames[SYMTAB], SHT_SYMTAB, 0, symtabOffset, symtab.size(), STRTAB, firstGlobal, 8, SYMBOL_SIZE);
+    addSection(sectionNames[STRTAB], SHT_STRTAB, 0, strtabOffset, strtab.size(), 0, 0, 1, 0);
+    addSection(sectionNames[NOTE_GNU_STACK], SHT_PROGBITS, 0, shstrtabOffset, 0, 0, 0, 1, 0);
+    addSection(sectionNames[SHSTRTAB], SHT_STRTAB, 0, shstrtabOffset, shstrtab.size(), 0, 0, 1, 0);
+
+    sink.write(sections);
+    return position + sections.size();
+}
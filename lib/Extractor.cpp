@@ -5,8 +5,8 @@
 #include <fstream>
 #include <sstream>
 #include <filesystem>
+#include <algorithm>
 
-#include <boost/tokenizer.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
@@ -34,15 +34,19 @@ std::map<std::string, std::string> parseJsonString(const std::string &jsonString
     return dictionary;
 }
 
-void extractOptionsAndVariables(const std::string &inputFilePath, std::map<std::string, std::string> &options, std::vector<std::map<std::string, std::string>> &variables)
+void extractOptionsAndVariables(const std::string &inputFilePath, std::map<std::string, std::string> &options, std::vector<std::map<std::string, std::string>> &variables, const bool keepContent)
 {
-    boost::char_separator<char> newlineSeparator("\n");
-
     bool currentVariable = false;
     std::map<std::string, std::string> currentVarDic;
     std::string currentContent;
     bool work = false;
     bool started = false;
+    bool foundTag = false;
+
+    // Position, length and last characters of the content, so it can be read later without keeping it in memory
+    std::streamoff contentOffset = 0;
+    std::size_t contentLength = 0;
+    std::string contentTail;
 
     // Differentiates between different @'s
     const std::string startString = "@start";
@@ -55,24 +59,21 @@ void extractOptionsAndVariables(const std::string &inputFilePath, std::map<std::
     int lineNumber = 0;
 
     std::ifstream inputFile(inputFilePath);
-    const std::string inputString((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
-    char x = '@';
-
-    // Check if @ even exists in the file
-    if (inputString.find(x) == std::string::npos)
-    {
-        return;
-    }
-
-    std::istringstream iss(inputString);
     std::string line;
 
     // Read all lines of the file, one after another ignoring text before @start and after @endcond
     // puts correct parameter in correct dictionary. Uses Boost to parse the parameter of the tags which have JSON Format
-    while (std::getline(iss, line))
+    // The file is read line by line, so only the content of the current variable is held (and only if keepContent is set)
+    while (std::getline(inputFile, line))
     {
         lineNumber++;
 
+        // Check if @ even exists in the file
+        if (!foundTag && line.find('@') != std::string::npos)
+        {
+            foundTag = true;
+        }
+
         // If @start and everything before the first ' ' are the same and if the currentVariable is false
         if (startString == line.substr(0, line.find(' ')) && currentVariable == false)
         {
@@ -112,6 +113,11 @@ void extractOptionsAndVariables(const std::string &inputFilePath, std::map<std::
                     currentVarDic = parseJsonString(variableString);
                     currentVarDic.insert({"VariableLineNumber", std::to_string(lineNumber)});
                     currentVariable = true;
+
+                    // The content starts with the next line
+                    contentOffset = std::max<std::streamoff>(inputFile.tellg(), 0);
+                    contentLength = 0;
+                    contentTail.clear();
                 }
             }
             // If @endvariable and everything before the first ' ' are the same
@@ -119,19 +125,33 @@ void extractOptionsAndVariables(const std::string &inputFilePath, std::map<std::
             {
                 currentVariable = false;
                 currentVarDic["content"] = currentContent;
+                currentVarDic["ContentOffset"] = std::to_string(contentOffset);
+                currentVarDic["ContentLength"] = std::to_string(contentLength);
+                currentVarDic["ContentTail"] = contentTail;
                 variables.push_back(currentVarDic);
                 currentContent.clear();
             }
             // If currentVariable  is still true, End of the Variable was reached
             else if (currentVariable)
             {
-                currentContent += line;
-                currentContent += "\n";
+                if (keepContent)
+                {
+                    currentContent += line;
+                    currentContent += "\n";
+                }
+                contentLength += line.size() + 1;
+
+                // keep the last two characters for the new line check
+                contentTail = (line.empty() ? contentTail : line.substr(line.size() - 1)) + "\n";
+                if (contentTail.size() > 2)
+                {
+                    contentTail.erase(0, contentTail.size() - 2);
+                }
             }
         }
     }
     // In case first if condition was never met, no @start Tag
-    if (started == false)
+    if (started == false && foundTag)
     {
         BOOST_LOG_TRIVIAL(fatal)
             << RED_COLOR << "This file has no @start-Tag: " << inputFilePath << RESET_COLOR << std::endl;
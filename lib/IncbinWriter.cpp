@@ -0,0 +1,124 @@
+#include <IncbinWriter.h>
+
+namespace
+{
+    /**
+     * @brief Quotes a path as string of the assembler.
+     */
+    std::string quotePath(const std::string &path)
+    {
+        std::string quoted = "\"";
+        for (const char c : path)
+        {
+            if (c == '\\' || c == '"')
+            {
+                quoted.push_back('\\');
+            }
+            quoted.push_back(c);
+        }
+        quoted.push_back('"');
+        return quoted;
+    }
+
+    /**
+     * @brief Starts a global data object, its size is set by endObject() behind the data.
+     */
+    std::string beginObject(const std::string &symbol)
+    {
+        return "\t.global " + symbol + "\n"
+               "\t.type " + symbol + ", %object\n" +
+               symbol + ":\n";
+    }
+
+    /**
+     * @brief Ends a global data object.
+     */
+    std::string endObject(const std::string &symbol)
+    {
+        return "\t.size " + symbol + ", . - " + symbol + "\n";
+    }
+}
+
+void IncbinWriter::addString(const std::string &symbol, const std::string &binaryPath, const std::size_t size)
+{
+    entries.push_back({symbol, binaryPath, size, true, true, 1, "", 0});
+}
+
+void IncbinWriter::addStringArray(const std::string &symbol, const std::string &binaryPath, const std::size_t size)
+{
+    entries.push_back({symbol, binaryPath, size, true, false, 1, "", 0});
+}
+
+void IncbinWriter::addStringAlias(const std::string &symbol, const std::string &target, const std::size_t offset, const std::size_t size)
+{
+    entries.push_back({symbol, "", size, true, true, 1, target, offset});
+}
+
+void IncbinWriter::addArray(const std::string &symbol, const std::string &binaryPath, const std::size_t size, const std::size_t alignment)
+{
+    entries.push_back({symbol, binaryPath, size, false, false, alignment, "", 0});
+}
+
+void IncbinWriter::write(OutputSink &sink) const
+{
+    sink.write("/* Generated by GenTxtSrcCode, the contents are included from the binary files */\n\n");
+
+    for (const Entry &entry : entries)
+    {
+        std::string code;
+        if (!entry.target.empty())
+        {
+            // the text of the target ends with the text of the alias
+            code.append("\t.section .data.rel.ro, \"aw\"\n");
+            code.append("\t.balign 8\n");
+            code.append(beginObject(entry.symbol));
+            code.append("\t.dc.a .L" + entry.target + "_data + " + std::to_string(entry.offset) + "\n");
+        }
+        else if (entry.isPointer)
+        {
+            // the text is local, the variable is a pointer to it
+            const std::string data = ".L" + entry.symbol + "_data";
+            code.append("\t.section .rodata\n");
+            code.append(data + ":\n");
+            code.append("\t.incbin " + quotePath(entry.binaryPath) + "\n");
+            code.append("\t.byte 0\n");
+            code.append("\t.section .data.rel.ro, \"aw\"\n");
+            code.append("\t.balign 8\n");
+            code.append(beginObject(entry.symbol));
+            code.append("\t.dc.a " + data + "\n");
+        }
+        else
+        {
+            code.append("\t.section .rodata\n");
+            if (entry.alignment > 1)
+            {
+                code.append("\t.balign " + std::to_string(entry.alignment) + "\n");
+            }
+            code.append(beginObject(entry.symbol));
+            code.append("\t.incbin " + quotePath(entry.binaryPath) + "\n");
+            if (entry.isString)
+            {
+                code.append("\t.byte 0\n");
+            }
+            if (entry.alignment > 1)
+            {
+                code.append("\t.balign " + std::to_string(entry.alignment) + ", 0\n");
+            }
+        }
+        code.append(endObject(entry.symbol));
+
+        code.append("\t.section .rodata\n");
+        code.append("\t.balign 8\n");
+        code.append(beginObject(entry.symbol + "_size"));
+        code.append("\t.dc.a " + std::to_string(entry.size) + "\n");
+        code.append(endObject(entry.symbol + "_size") + "\n");
+        sink.write(code);
+    }
+
+    sink.write("\t.section .note.GNU-stack, \"\", %progbits\n");
+}
+
+std::string IncbinWriter::sizeDeclaration(const std::string &symbol)
+{
+    return "extern const size_t " + symbol + "_size;\n";
+}
@@ -0,0 +1,65 @@
+#include <LineEmitter.h>
+
+template <NewLineMode Mode>
+LineEmitter<Mode>::LineEmitter(OutputSink &output, const int &signPerLine, const std::string &quote)
+    : output(output), quote(quote), signPerLine(signPerLine > 0 ? signPerLine : 0)
+{
+    line.reserve(this->signPerLine + 16);
+}
+
+template <NewLineMode Mode>
+void LineEmitter<Mode>::writePart(const char *data, const std::size_t length)
+{
+    if (!lineOpen)
+    {
+        output.write(quote);
+        lineOpen = true;
+    }
+    output.write(data, length);
+    written += length;
+}
+
+template <NewLineMode Mode>
+void LineEmitter<Mode>::closeLine()
+{
+    if (lineOpen)
+    {
+        output.write(quote);
+        output.write(" \\\n", 3);
+        lineOpen = false;
+    }
+    written = 0;
+    unitColumn = 0;
+}
+
+template <NewLineMode Mode>
+void LineEmitter<Mode>::breakBeforeUnit()
+{
+    writePart(line.data(), unitStart);
+    closeLine();
+    line.erase(0, unitStart);
+    unitStart = 0;
+}
+
+template <NewLineMode Mode>
+void LineEmitter<Mode>::flushLine()
+{
+    writePart(line.data(), line.size());
+    closeLine();
+    line.clear();
+    unitStart = 0;
+}
+
+template <NewLineMode Mode>
+void LineEmitter<Mode>::finish()
+{
+    endUnit();
+    if (lineOpen || !line.empty())
+    {
+        flushLine();
+    }
+}
+
+template class LineEmitter<NewLineMode::UNIX>;
+template class LineEmitter<NewLineMode::DOS>;
+template class LineEmitter<NewLineMode::MAC>;
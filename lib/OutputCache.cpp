@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <Logger.h>
+#include <ByteSource.h>
+#include <OutputCache.h>
+
+namespace
+{
+    const std::string MANIFEST_NAME = "manifest";
+    const std::string STATISTICS_NAME = "stats";
+
+    std::string manifestHead()
+    {
+        return "GenTxtSrcCode output cache " + std::to_string(OUTPUT_CACHE_VERSION);
+    }
+
+    /**
+     * @brief An entry found by finish().
+     */
+    struct Entry
+    {
+        std::filesystem::path path;
+        std::filesystem::file_time_type used;
+        std::uintmax_t size = 0;
+    };
+
+    std::vector<Entry> listEntries(const std::filesystem::path &directory)
+    {
+        std::vector<Entry> entries;
+        std::error_code error;
+        for (const std::filesystem::directory_entry &prefix : std::filesystem::directory_iterator(directory, error))
+        {
+            // the entries are two levels deep, below the first two characters of their key
+            if (!prefix.is_directory() || prefix.path().filename().string().size() != 2)
+            {
+                continue;
+            }
+            for (const std::filesystem::directory_entry &entryDirectory : std::filesystem::directory_iterator(prefix.path(), error))
+            {
+                Entry entry;
+                entry.path = entryDirectory.path();
+                entry.used = std::filesystem::last_write_time(entry.path / MANIFEST_NAME, error);
+                if (error)
+                {
+                    // evicted by another run in the meantime
+                    continue;
+                }
+                for (const std::filesystem::directory_entry &file : std::filesystem::directory_iterator(entry.path, error))
+                {
+                    entry.size += file.is_regular_file() ? file.file_size() : 0;
+                }
+                entries.push_back(entry);
+            }
+        }
+        return entries;
+    }
+}
+
+void CacheKey::add(const char *data, const std::size_t length)
+{
+    // the FNV prime is 2^88 + 315, the product is built from the halves, only its lower 128 bits are kept
+    for (std::size_t i = 0; i < length; i++)
+    {
+        low ^= static_cast<unsigned char>(data[i]);
+        const std::uint64_t carry = ((low >> 32) * 315 + (((low & 0xffffffffull) * 315) >> 32)) >> 32;
+        high = high * 315 + carry + (low << 24);
+        low = low * 315;
+    }
+}
+
+void CacheKey::addText(const std::string &text)
+{
+    const std::string length = std::to_string(text.size()) + ":";
+    add(length.data(), length.size());
+    add(text.data(), text.size());
+}
+
+void CacheKey::addSource(ByteSource &source)
+{
+    addText(std::to_string(source.size()));
+    source.rewind();
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::size_t length;
+    while ((length = source.read(buffer.data(), buffer.size())) > 0)
+    {
+        add(buffer.data(), length);
+    }
+}
+
+std::string CacheKey::toString() const
+{
+    std::ostringstream text;
+    text << std::hex << std::setfill('0') << std::setw(16) << high << std::setw(16) << low;
+    return text.str();
+}
+
+OutputCache::OutputCache(const std::filesystem::path &directory, const std::uintmax_t maxSize)
+    : directory(directory), maxSize(maxSize)
+{
+    std::filesystem::create_directories(directory);
+}
+
+std::filesystem::path OutputCache::entryPath(const CacheKey &key) const
+{
+    const std::string name = key.toString();
+    return directory / name.substr(0, 2) / name.substr(2);
+}
+
+std::filesystem::path OutputCache::temporaryPath() const
+{
+    std::random_device random;
+    return directory / "tmp" / (std::to_string(random()) + "_" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())));
+}
+
+bool OutputCache::restore(const CacheKey &key, const std::filesystem::path &headerDirectory,
+                          const std::filesystem::path &sourceDirectory, std::vector<std::filesystem::path> &restored,
+                          std::size_t &unchangedFiles)
+{
+    const std::filesystem::path entry = entryPath(key);
+    std::ifstream manifest(entry / MANIFEST_NAME);
+    std::string line;
+    if (!manifest.is_open() || !std::getline(manifest, line) || line != manifestHead())
+    {
+        misses++;
+        return false;
+    }
+
+    // the entry is only used for the same key, not for one that just ends in the same directory
+    if (!std::getline(manifest, line) || line != "key " + key.toString())
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Ignoring the cache entry " << entry.string() << ": it was stored for another key";
+        misses++;
+        return false;
+    }
+
+    try
+    {
+        std::filesystem::create_directories(headerDirectory);
+        std::filesystem::create_directories(sourceDirectory);
+        for (std::size_t index = 0; std::getline(manifest, line); index++)
+        {
+            // "h NAME" for the header, "s NAME" for a file next to the source
+            if (line.size() < 3 || (line[0] != 'h' && line[0] != 's'))
+            {
+                throw std::runtime_error("damaged manifest");
+            }
+            const std::filesystem::path cachedFile = entry / std::to_string(index);
+            const std::filesystem::path target = (line[0] == 'h' ? headerDirectory : sourceDirectory) / line.substr(2);
+            FileRangeSource content(cachedFile.string(), 0, static_cast<std::size_t>(std::filesystem::file_size(cachedFile)));
+            if (!copyToFile(content, target.string()))
+            {
+                unchangedFiles++;
+            }
+            restored.push_back(target);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Ignoring the cache entry " << entry.string() << ": " << e.what();
+        misses++;
+        return false;
+    }
+
+    // the time of the manifest is the last use for the eviction
+    std::error_code error;
+    std::filesystem::last_write_time(entry / MANIFEST_NAME, std::filesystem::file_time_type::clock::now(), error);
+    hits++;
+    return true;
+}
+
+void OutputCache::store(const CacheKey &key, const std::filesystem::path &headerFile,
+                        const std::vector<std::filesystem::path> &sourceFiles)
+{
+    const std::filesystem::path entry = entryPath(key);
+    const std::filesystem::path temporary = temporaryPath();
+    std::error_code error;
+    try
+    {
+        std::filesystem::create_directories(temporary);
+        std::ofstream manifest(temporary / MANIFEST_NAME);
+        manifest << manifestHead() << "\n";
+        manifest << "key " << key.toString() << "\n";
+
+        std::vector<std::filesystem::path> files = {headerFile};
+        files.insert(files.end(), sourceFiles.begin(), sourceFiles.end());
+        for (std::size_t index = 0; index < files.size(); index++)
+        {
+            std::filesystem::copy_file(files[index], temporary / std::to_string(index));
+            manifest << (index == 0 ? "h " : "s ") << files[index].filename().string() << "\n";
+        }
+        manifest.close();
+        if (!manifest)
+        {
+            throw std::runtime_error("Could not write the manifest");
+        }
+
+        // another run may have added the same entry in the meantime, then it is kept
+        std::filesystem::create_directories(entry.parent_path());
+        std::filesystem::rename(temporary, entry, error);
+        if (!error)
+        {
+            stored++;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "Could not add to the cache " << directory.string() << ": " << e.what();
+    }
+    std::filesystem::remove_all(temporary, error);
+}
+
+void OutputCache::finish()
+{
+    std::vector<Entry> entries = listEntries(directory);
+    std::uintmax_t size = 0;
+    for (const Entry &entry : entries)
+    {
+        size += entry.size;
+    }
+
+    // the oldest entries go until a tenth of the size is free, so not every run has to evict
+    std::size_t evicted = 0;
+    if (size > maxSize)
+    {
+        std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+                  { return a.used < b.used; });
+        for (const Entry &entry : entries)
+        {
+            if (size <= maxSize - maxSize / 10)
+            {
+                break;
+            }
+            std::error_code error;
+            std::filesystem::remove_all(entry.path, error);
+            size -= entry.size;
+            evicted++;
+        }
+    }
+
+    // the counters of all runs, another run may write the file at the same time, then one of them is lost
+    std::map<std::string, std::size_t> statistics;
+    std::ifstream previous(directory / STATISTICS_NAME);
+    std::string name;
+    std::size_t count;
+    while (previous >> name >> count)
+    {
+        statistics[name] = count;
+    }
+    previous.close();
+    statistics["hits"] += hits;
+    statistics["misses"] += misses;
+    statistics["stored"] += stored;
+    statistics["evicted"] += evicted;
+
+    const std::filesystem::path temporary = temporaryPath();
+    std::error_code error;
+    std::filesystem::create_directories(temporary.parent_path(), error);
+    {
+        std::ofstream file(temporary);
+        for (const std::pair<const std::string, std::size_t> &counter : statistics)
+        {
+            file << counter.first << " " << counter.second << "\n";
+        }
+    }
+    std::filesystem::rename(temporary, directory / STATISTICS_NAME, error);
+    if (error)
+    {
+        std::filesystem::remove(temporary, error);
+    }
+
+    BOOST_LOG_TRIVIAL(info) << "Output cache: " << directory.string() << " hits: " << hits << " misses: " << misses
+                            << " stored: " << stored << " evicted: " << evicted << " size: " << size
+                            << " of " << maxSize << " bytes" << std::endl;
+}
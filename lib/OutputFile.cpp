@@ -0,0 +1,80 @@
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+
+#include <ByteSource.h>
+#include <OutputFile.h>
+
+namespace
+{
+    // true if both files exist with the same bytes
+    bool sameContent(const std::filesystem::path &first, const std::filesystem::path &second)
+    {
+        std::error_code error;
+        const std::uintmax_t size = std::filesystem::file_size(second, error);
+        if (error || size != std::filesystem::file_size(first))
+        {
+            return false;
+        }
+
+        std::ifstream firstFile(first, std::ios::binary);
+        std::ifstream secondFile(second, std::ios::binary);
+        std::vector<char> firstBuffer(SOURCE_CHUNK_SIZE);
+        std::vector<char> secondBuffer(SOURCE_CHUNK_SIZE);
+        while (firstFile && secondFile)
+        {
+            firstFile.read(firstBuffer.data(), static_cast<std::streamsize>(firstBuffer.size()));
+            secondFile.read(secondBuffer.data(), static_cast<std::streamsize>(secondBuffer.size()));
+            if (firstFile.gcount() != secondFile.gcount() ||
+                std::memcmp(firstBuffer.data(), secondBuffer.data(), static_cast<std::size_t>(firstFile.gcount())) != 0)
+            {
+                return false;
+            }
+        }
+        return firstFile.eof() && secondFile.eof();
+    }
+}
+
+OutputFile::OutputFile(const std::filesystem::path &path, const bool binary)
+    : path(path), temporaryPath(path.string() + ".tmp")
+{
+    file.open(temporaryPath, binary ? std::ios::binary | std::ios::trunc : std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Could not open: " + path.string());
+    }
+}
+
+OutputFile::~OutputFile()
+{
+    if (!committed)
+    {
+        file.close();
+        std::error_code error;
+        std::filesystem::remove(temporaryPath, error);
+    }
+}
+
+std::ofstream &OutputFile::stream()
+{
+    return file;
+}
+
+bool OutputFile::commit()
+{
+    committed = true;
+    file.close();
+    if (file.fail())
+    {
+        std::filesystem::remove(temporaryPath);
+        throw std::runtime_error("Could not write: " + path.string());
+    }
+
+    if (sameContent(temporaryPath, path))
+    {
+        std::filesystem::remove(temporaryPath);
+        return false;
+    }
+    std::filesystem::rename(temporaryPath, path);
+    return true;
+}
@@ -0,0 +1,57 @@
+#include <OutputSink.h>
+
+OutputSink::~OutputSink()
+{
+}
+
+void OutputSink::write(const std::string &text)
+{
+    write(text.data(), text.size());
+}
+
+StringSink::StringSink(std::string &text, const std::size_t expectedSize) : text(text), capacity(text.capacity())
+{
+    if (expectedSize > 0)
+    {
+        text.reserve(text.size() + expectedSize);
+        if (text.capacity() != capacity)
+        {
+            capacity = text.capacity();
+            allocationCount++;
+        }
+    }
+}
+
+void StringSink::write(const char *data, const std::size_t length)
+{
+    text.append(data, length);
+    if (text.capacity() != capacity)
+    {
+        capacity = text.capacity();
+        allocationCount++;
+    }
+}
+
+std::size_t StringSink::allocations() const
+{
+    return allocationCount;
+}
+
+void CountingSink::write(const char *, const std::size_t length)
+{
+    count += length;
+}
+
+std::size_t CountingSink::size() const
+{
+    return count;
+}
+
+StreamSink::StreamSink(std::ostream &stream) : stream(stream)
+{
+}
+
+void StreamSink::write(const char *data, const std::size_t length)
+{
+    stream.write(data, static_cast<std::streamsize>(length));
+}
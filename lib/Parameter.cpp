@@ -11,6 +11,11 @@ void printParamStruct(const ParamStruct &paramStruct)
     std::cout << "Namespace Name: " << CYAN_COLOR << (paramStruct.namespaceName) << RESET_COLOR << std::endl;
     std::cout << "Sign Per Line: " << CYAN_COLOR << paramStruct.signPerLine << RESET_COLOR << std::endl;
     std::cout << "Sort By Variable Name: " << CYAN_COLOR << paramStruct.sortByVarname << RESET_COLOR << std::endl;
+    std::cout << "Parallel Threshold: " << CYAN_COLOR << paramStruct.parallelThreshold << RESET_COLOR << std::endl;
+    std::cout << "Array Definitions: " << CYAN_COLOR << paramStruct.arrayDefinitions << RESET_COLOR << std::endl;
+    std::cout << "Packed Blob: " << CYAN_COLOR << paramStruct.packedBlob << RESET_COLOR << std::endl;
+    std::cout << "Name Lookup: " << CYAN_COLOR << paramStruct.nameLookup << RESET_COLOR << std::endl;
+    std::cout << "Variable Cache: " << CYAN_COLOR << paramStruct.variableCache << RESET_COLOR << std::endl;
     std::cout << std::endl;
 }
 
@@ -24,4 +29,71 @@ void printParamStruct(const VariableStruct &variableStruct)
     std::cout << "Variables Content: " << CYAN_COLOR << variableStruct.content << RESET_COLOR << std::endl;
     std::cout << "The Encoding Type: " << CYAN_COLOR << variableStruct.seq << RESET_COLOR << std::endl;
     std::cout << std::endl;
-}
\ No newline at end of file
+}
+SeqType toSeqType(const std::string &seq)
+{
+    if (seq == "HEX")
+    {
+        return SeqType::HEX;
+    }
+    else if (seq == "OCT")
+    {
+        return SeqType::OCT;
+    }
+    else if (seq == "RAWHEX")
+    {
+        return SeqType::RAWHEX;
+    }
+    else if (seq == "EMBED")
+    {
+        return SeqType::EMBED;
+    }
+    else if (seq == "RAWHEX32")
+    {
+        return SeqType::RAWHEX32;
+    }
+    else if (seq == "RAWHEX64")
+    {
+        return SeqType::RAWHEX64;
+    }
+    else if (seq == "AUTO")
+    {
+        return SeqType::AUTO;
+    }
+    else if (seq == "RAW")
+    {
+        return SeqType::RAW;
+    }
+    return SeqType::ESC;
+}
+
+bool isArraySeq(const SeqType seq)
+{
+    return seq == SeqType::RAWHEX || seq == SeqType::EMBED || seq == SeqType::RAWHEX32 || seq == SeqType::RAWHEX64;
+}
+
+std::size_t seqWordSize(const SeqType seq)
+{
+    if (seq == SeqType::RAWHEX32)
+    {
+        return 4;
+    }
+    if (seq == SeqType::RAWHEX64)
+    {
+        return 8;
+    }
+    return 1;
+}
+
+NewLineMode toNewLineMode(const std::string &nl)
+{
+    if (nl == "DOS")
+    {
+        return NewLineMode::DOS;
+    }
+    else if (nl == "MAC")
+    {
+        return NewLineMode::MAC;
+    }
+    return NewLineMode::UNIX;
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include <PerfectHash.h>
+
+namespace
+{
+    // displacements a bucket tries before the slot table is doubled
+    constexpr std::uint32_t MAX_DISPLACEMENT = 1u << 16;
+
+    // slots per name after which no table is tried any more, unique names never get that far
+    constexpr std::size_t MAX_SLOTS_PER_NAME = 64;
+
+    std::size_t powerOfTwo(const std::size_t minimum)
+    {
+        std::size_t size = 1;
+        while (size < minimum)
+        {
+            size *= 2;
+        }
+        return size;
+    }
+
+    // fills the tables with the given slot count, false if a bucket found no displacement
+    bool placeNames(const std::vector<std::string> &names, PerfectHash &hash)
+    {
+        const std::size_t bucketMask = hash.displacements.size() - 1;
+        const std::size_t slotMask = hash.slots.size() - 1;
+
+        std::vector<std::vector<std::uint32_t>> buckets(hash.displacements.size());
+        for (std::uint32_t i = 0; i < names.size(); i++)
+        {
+            buckets[hashName(names[i], 0) & bucketMask].push_back(i);
+        }
+        std::vector<std::size_t> order(buckets.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](const std::size_t a, const std::size_t b)
+                         { return buckets[a].size() > buckets[b].size(); });
+
+        std::vector<bool> used(hash.slots.size(), false);
+        std::vector<std::size_t> placed;
+        for (const std::size_t bucket : order)
+        {
+            if (buckets[bucket].empty())
+            {
+                break;
+            }
+
+            std::uint32_t displacement = 1;
+            for (; displacement <= MAX_DISPLACEMENT; displacement++)
+            {
+                placed.clear();
+                for (const std::uint32_t index : buckets[bucket])
+                {
+                    const std::size_t slot = hashName(names[index], displacement) & slotMask;
+                    if (used[slot] || std::find(placed.begin(), placed.end(), slot) != placed.end())
+                    {
+                        break;
+                    }
+                    placed.push_back(slot);
+                }
+                if (placed.size() == buckets[bucket].size())
+                {
+                    break;
+                }
+            }
+            if (displacement > MAX_DISPLACEMENT)
+            {
+                return false;
+            }
+
+            hash.displacements[bucket] = displacement;
+            for (std::size_t i = 0; i < placed.size(); i++)
+            {
+                used[placed[i]] = true;
+                hash.slots[placed[i]] = buckets[bucket][i];
+            }
+        }
+        return true;
+    }
+}
+
+std::uint32_t hashName(const std::string &name, const std::uint32_t seed)
+{
+    std::uint32_t hash = 2166136261u ^ (seed * 2654435769u);
+    for (const unsigned char c : name)
+    {
+        hash = (hash ^ c) * 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 2146121005u;
+    hash ^= hash >> 15;
+    return hash;
+}
+
+PerfectHash buildPerfectHash(const std::vector<std::string> &names)
+{
+    // about four names share a bucket, the slot table is filled up to its size
+    PerfectHash hash;
+    std::size_t slotCount = powerOfTwo(std::max<std::size_t>(names.size(), 1));
+    while (true)
+    {
+        hash.displacements.assign(powerOfTwo(std::max<std::size_t>((names.size() + 3) / 4, 1)), 0);
+        hash.slots.assign(slotCount, 0);
+        if (placeNames(names, hash))
+        {
+            return hash;
+        }
+        slotCount *= 2;
+        if (slotCount > MAX_SLOTS_PER_NAME * std::max<std::size_t>(names.size(), 1))
+        {
+            // two equal names always hash to the same slot
+            throw std::invalid_argument("No perfect hash found, the names are not unique");
+        }
+    }
+}
+
+std::size_t findSlot(const PerfectHash &hash, const std::string &name)
+{
+    const std::uint32_t displacement = hash.displacements[hashName(name, 0) & (hash.displacements.size() - 1)];
+    return hashName(name, displacement) & (hash.slots.size() - 1);
+}
+
+std::string writeHashFunction(const std::string &functionName)
+{
+    return "static inline uint32_t " + functionName + "(const char *name, size_t length, uint32_t seed)\n"
+           "{\n"
+           "    uint32_t hash = 2166136261u ^ (seed * 2654435769u);\n"
+           "    size_t i;\n"
+           "    for (i = 0; i < length; i++)\n"
+           "    {\n"
+           "        hash = (hash ^ (unsigned char)name[i]) * 16777619u;\n"
+           "    }\n"
+           "    hash ^= hash >> 16;\n"
+           "    hash *= 2146121005u;\n"
+           "    hash ^= hash >> 15;\n"
+           "    return hash;\n"
+           "}\n";
+}
@@ -0,0 +1,80 @@
+#include <algorithm>
+
+#include <ThreadPool.h>
+
+std::size_t ThreadPool::sharedSize = 0;
+
+ThreadPool::ThreadPool(const std::size_t threads)
+{
+    for (std::size_t i = 0; i < std::max<std::size_t>(threads, 1); i++)
+    {
+        workers.emplace_back([this]()
+                             { work(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::size() const
+{
+    return workers.size();
+}
+
+ThreadPool &ThreadPool::shared()
+{
+    static ThreadPool pool(sharedSize != 0 ? sharedSize : std::thread::hardware_concurrency());
+    return pool;
+}
+
+void ThreadPool::setSharedSize(const std::size_t threads)
+{
+    sharedSize = threads;
+}
+
+bool ThreadPool::runPendingTask()
+{
+    std::function<void()> task;
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty())
+        {
+            return false;
+        }
+        task = std::move(tasks.front());
+        tasks.pop_front();
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::work()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]()
+                           { return stopping || !tasks.empty(); });
+            if (tasks.empty())
+            {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,139 @@
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <Logger.h>
+#include <VariableCache.h>
+
+namespace
+{
+    // the first line of the index, it names the source the positions belong to
+    std::string indexHead(const std::filesystem::path &sourceFilePath)
+    {
+        std::error_code error;
+        const std::uintmax_t size = std::filesystem::file_size(sourceFilePath, error);
+        if (error)
+        {
+            return "";
+        }
+        const auto time = std::filesystem::last_write_time(sourceFilePath, error).time_since_epoch().count();
+        if (error)
+        {
+            return "";
+        }
+        return "GenTxtSrcCode cache " + std::to_string(VARIABLE_CACHE_VERSION) + " " + std::to_string(size) + " " +
+               std::to_string(time);
+    }
+}
+
+std::uint64_t hashBytes(std::uint64_t hash, const char *data, const std::size_t length)
+{
+    for (std::size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+    }
+    return hash;
+}
+
+std::uint64_t hashText(const std::uint64_t hash, const std::string &text)
+{
+    const std::string length = std::to_string(text.size()) + ":";
+    return hashBytes(hashBytes(hash, length.data(), length.size()), text.data(), text.size());
+}
+
+std::uint64_t hashSource(std::uint64_t hash, ByteSource &source)
+{
+    hash = hashText(hash, std::to_string(source.size()));
+    source.rewind();
+    std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+    std::size_t length;
+    while ((length = source.read(buffer.data(), buffer.size())) > 0)
+    {
+        hash = hashBytes(hash, buffer.data(), length);
+    }
+    return hash;
+}
+
+VariableCache::VariableCache(const std::filesystem::path &sourceFilePath)
+    : sourceFilePath(sourceFilePath), cacheFilePath(sourceFilePath.string() + ".cache")
+{
+    std::ifstream index(cacheFilePath);
+    std::string head;
+    if (!index.is_open() || !std::getline(index, head) || head.empty() || head != indexHead(sourceFilePath))
+    {
+        return;
+    }
+
+    std::string line;
+    while (std::getline(index, line))
+    {
+        std::istringstream entry(line);
+        std::uint64_t key;
+        Range range;
+        if (!(entry >> std::hex >> key >> std::dec >> range.offset >> range.length))
+        {
+            BOOST_LOG_TRIVIAL(warning) << "Ignoring the damaged cache: " << cacheFilePath.string();
+            previous.clear();
+            return;
+        }
+        previous[key] = range;
+    }
+    previousSource.open(sourceFilePath, std::ios::binary);
+    if (!previousSource.is_open())
+    {
+        previous.clear();
+    }
+}
+
+bool VariableCache::contains(const std::uint64_t key) const
+{
+    return previous.count(key) > 0;
+}
+
+std::size_t VariableCache::copy(const std::uint64_t key, OutputSink &sink)
+{
+    const Range &range = previous.at(key);
+    previousSource.clear();
+    previousSource.seekg(static_cast<std::streamoff>(range.offset));
+
+    std::vector<char> buffer(std::min(range.length, SOURCE_CHUNK_SIZE));
+    std::size_t remaining = range.length;
+    while (remaining > 0)
+    {
+        const std::size_t count = std::min(remaining, buffer.size());
+        previousSource.read(buffer.data(), static_cast<std::streamsize>(count));
+        if (static_cast<std::size_t>(previousSource.gcount()) != count)
+        {
+            throw std::runtime_error("Could not read the cached code from: " + sourceFilePath.string());
+        }
+        sink.write(buffer.data(), count);
+        remaining -= count;
+    }
+    return range.length;
+}
+
+void VariableCache::record(const std::uint64_t key, const std::size_t offset, const std::size_t length)
+{
+    current[key] = {offset, length};
+}
+
+bool VariableCache::commit(OutputFile &sourceFile)
+{
+    previousSource.close();
+    const bool written = sourceFile.commit();
+
+    // the entries are sorted by position, so the same source gets the same index
+    std::vector<std::pair<std::uint64_t, Range>> entries(current.begin(), current.end());
+    std::sort(entries.begin(), entries.end(), [](const std::pair<std::uint64_t, Range> &a, const std::pair<std::uint64_t, Range> &b)
+              { return a.second.offset < b.second.offset; });
+
+    OutputFile index(cacheFilePath);
+    index.stream() << indexHead(sourceFilePath) << "\n";
+    for (const std::pair<std::uint64_t, Range> &entry : entries)
+    {
+        index.stream() << std::hex << entry.first << std::dec << " " << entry.second.offset << " " << entry.second.length << "\n";
+    }
+    index.commit();
+    return written;
+}
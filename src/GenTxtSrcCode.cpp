@@ -5,6 +5,13 @@
 #include <cctype>
 #include <sstream>
 #include <algorithm>
+#include <deque>
+#include <memory>
+#include <future>
+#include <stdexcept>
+#include <set>
+#include <atomic>
+#include <limits>
 
 #include <ConsoleColors.h>
 #include <Extractor.h>
@@ -13,6 +20,19 @@
 #include <CTextToHexSeq.h>
 #include <CTextToOctSeq.h>
 #include <CTextToRawHexSeq.h>
+#include <CTextToAutoSeq.h>
+#include <CTextToRawSeq.h>
+#include <ByteSource.h>
+#include <OutputSink.h>
+#include <OutputFile.h>
+#include <VariableCache.h>
+#include <OutputCache.h>
+#include <ThreadPool.h>
+#include <AsciiValidator.h>
+#include <ElfObjectWriter.h>
+#include <IncbinWriter.h>
+#include <PerfectHash.h>
+#include <DependencyFile.h>
 
 #include <GenTxtSrcCode.h>
 
@@ -38,10 +58,22 @@ void GenTxtSrcCode::printHelpText()
 
     std::cout << "-H, --headerdir <dir>     " << BLUE_COLOR << "Header file directory" << RESET_COLOR << "\n";
     std::cout << "-S, --sourcedir <dir>     " << BLUE_COLOR << "Source file directory" << RESET_COLOR << "\n";
-    std::cout << "-t, --outputtype <type>  " << BLUE_COLOR << "Output file type (C or CPP)" << RESET_COLOR << "\n";
+    std::cout << "-t, --outputtype <type>  " << BLUE_COLOR << "Output file type (C, CPP, O for an ELF object file or S for an assembler file with .incbin)" << RESET_COLOR << "\n";
     std::cout << "-f, --outputfilename <name>  " << BLUE_COLOR << "Output filename (without extension)" << RESET_COLOR << "\n";
     std::cout << "-n, --namespace <name>        " << BLUE_COLOR << "Flag to use namespaces" << RESET_COLOR << "\n";
     std::cout << "-l, --signperline <number>    " << BLUE_COLOR << "Number of characters per line" << RESET_COLOR << "\n";
+    std::cout << "-p, --parallelthreshold <bytes> " << BLUE_COLOR << "Variable size from which it is converted in parallel blocks" << RESET_COLOR << "\n";
+    std::cout << "-j, --jobs <number>           " << BLUE_COLOR << "Number of input files that are generated at the same time" << RESET_COLOR << "\n";
+    std::cout << "-d, --cachedir <dir>          " << BLUE_COLOR << "Directory of a cache with the generated files, shared by several build trees" << RESET_COLOR << "\n";
+    std::cout << "-m, --cachesize <megabytes>   " << BLUE_COLOR << "Size the cache may take, the least recently used files are removed first (default 1024)" << RESET_COLOR << "\n";
+    std::cout << "-D, --depfile <file>          " << BLUE_COLOR << "Write a make rule with the generated files and the input files for make or ninja" << RESET_COLOR << "\n";
+    std::cout << "-T, --deptarget <file>        " << BLUE_COLOR << "Target of the make rule in the depfile instead of the generated files, e.g. a stamp file" << RESET_COLOR << "\n";
+    std::cout << "-O, --printoutputs <file>     " << BLUE_COLOR << "Only list the files that would be generated in the file, one per line" << RESET_COLOR << "\n";
+    std::cout << "-a, --arraydefinitions        " << BLUE_COLOR << "Flag to define strings as char arrays with a NAME_size constant" << RESET_COLOR << "\n";
+    std::cout << "-b, --blob                    " << BLUE_COLOR << "Flag to pack all variables of a file into one array with an offset table and accessors" << RESET_COLOR << "\n";
+    std::cout << "-L, --lookup                  " << BLUE_COLOR << "Flag to add a lookup of the variables by name to the header" << RESET_COLOR << "\n";
+    std::cout << "-c, --cache                   " << BLUE_COLOR << "Flag to keep an index of the converted variables and only convert the changed ones again" << RESET_COLOR << "\n";
+    std::cout << "-s, --sharefiles              " << BLUE_COLOR << "Flag to share equal contents across the C or C++ sources of all input files, which have to be linked together" << RESET_COLOR << "\n";
     std::cout << "-C, --check                   " << BLUE_COLOR << "Flag to just create without checking the paths" << RESET_COLOR << "\n";
     std::cout << "-h, --help                    " << BLUE_COLOR << "Print help message" << RESET_COLOR << "\n";
 
@@ -69,10 +101,18 @@ std::string GenTxtSrcCode::checkLanguageType(const std::string &input)
     {
         return "c";
     }
+    else if (input_lower == "o" || input_lower == "obj" || input_lower == "elf")
+    {
+        return "o";
+    }
+    else if (input_lower == "s" || input_lower == "asm" || input_lower == "incbin")
+    {
+        return "S";
+    }
 
     BOOST_LOG_TRIVIAL(fatal) << RED_COLOR << "Cannot deterimine: " << BLUE_COLOR << "'" << input << "'" << RED_COLOR << " as a Language."
                              << "\n"
-                             << "We have " << CYAN_COLOR << "c " << RED_COLOR << "or " << CYAN_COLOR << "cpp " << RED_COLOR << "as option" << RESET_COLOR << std::endl;
+                             << "We have " << CYAN_COLOR << "c" << RED_COLOR << ", " << CYAN_COLOR << "cpp" << RED_COLOR << ", " << CYAN_COLOR << "o " << RED_COLOR << "or " << CYAN_COLOR << "S " << RED_COLOR << "as option" << RESET_COLOR << std::endl;
     exit(1);
 }
 
@@ -151,7 +191,7 @@ void GenTxtSrcCode::parseOptions()
     int optionIndex;
 
     BOOST_LOG_TRIVIAL(info) << "Checking for User-Input";
-    while ((opt = getopt_long(argc, argv, "H:S:t:f:n:l:Ch", longOptions, &optionIndex)) != -1)
+    while ((opt = getopt_long(argc, argv, "H:S:t:f:n:l:p:j:d:m:D:T:O:abLcsCh", longOptions, &optionIndex)) != -1)
     {
         std::string optionName;
         if (optionIndex > optionsAmount - 1 || optionIndex < 0)
@@ -186,6 +226,46 @@ void GenTxtSrcCode::parseOptions()
         case 'l':
             parameterInfo.signPerLine = std::stoi(optarg);
             break;
+        case 'p':
+            parameterInfo.parallelThreshold = std::stoull(optarg);
+            break;
+        case 'j':
+            jobs = std::stoi(optarg);
+            if (jobs > 1)
+            {
+                ThreadPool::setSharedSize(jobs);
+            }
+            break;
+        case 'd':
+            cacheDirectory = optarg;
+            break;
+        case 'm':
+            cacheSize = std::stoull(optarg);
+            break;
+        case 'D':
+            depFile = optarg;
+            break;
+        case 'T':
+            depTarget = optarg;
+            break;
+        case 'O':
+            outputListFile = optarg;
+            break;
+        case 'a':
+            parameterInfo.arrayDefinitions = true;
+            break;
+        case 'b':
+            parameterInfo.packedBlob = true;
+            break;
+        case 'L':
+            parameterInfo.nameLookup = true;
+            break;
+        case 'c':
+            parameterInfo.variableCache = true;
+            break;
+        case 's':
+            shareFiles = true;
+            break;
         case 'C':
             checkArgs = false;
             break;
@@ -193,7 +273,7 @@ void GenTxtSrcCode::parseOptions()
             printHelpText();
             exit(0);
         case '?':
-            if ((optopt == 'O' || optopt == 'H' || optopt == 'S' || optopt == 't' || optopt == 'f' || optopt == 'n' || optopt == 'l'))
+            if ((optopt == 'O' || optopt == 'H' || optopt == 'S' || optopt == 't' || optopt == 'f' || optopt == 'n' || optopt == 'l' || optopt == 'p' || optopt == 'j'))
             {
                 BOOST_LOG_TRIVIAL(fatal) << ORANGE_COLOR << "OK ... option " << optionName << "' without argument"
                                          << RESET_COLOR << std::endl;
@@ -276,6 +356,16 @@ void GenTxtSrcCode::checkOptions(std::map<std::string, std::string> &options)
         }
         parameterInfo.signPerLine = std::stoi(optValue);
     }
+    if (parameterInfo.parallelThreshold == 0)
+    {
+        optValue = options["parallelthreshold"];
+
+        if (optValue.empty())
+        {
+            optValue = "4194304";
+        }
+        parameterInfo.parallelThreshold = std::stoull(optValue);
+    }
 
     if (parameterInfo.sortByVarname == 0)
     {
@@ -293,6 +383,23 @@ void GenTxtSrcCode::checkOptions(std::map<std::string, std::string> &options)
             parameterInfo.sortByVarname = false;
         }
     }
+
+    if (parameterInfo.arrayDefinitions == false)
+    {
+        parameterInfo.arrayDefinitions = (options["arraydefinitions"] == "true");
+    }
+    if (parameterInfo.packedBlob == false)
+    {
+        parameterInfo.packedBlob = (options["blob"] == "true");
+    }
+    if (parameterInfo.nameLookup == false)
+    {
+        parameterInfo.nameLookup = (options["lookup"] == "true");
+    }
+    if (parameterInfo.variableCache == false)
+    {
+        parameterInfo.variableCache = (options["cache"] == "true");
+    }
 }
 
 void GenTxtSrcCode::checkVariable(std::map<std::string, std::string> &variable, const std::string &filename)
@@ -339,12 +446,27 @@ void GenTxtSrcCode::checkVariable(std::map<std::string, std::string> &variable,
         exit(1);
     }
     variableInfo.seq = toUpperCase(variable["seq"]);
-    if (!(variableInfo.seq == "ESC" || variableInfo.seq == "HEX" || variableInfo.seq == "OCT" || variableInfo.seq == "RAWHEX"))
+    if (!(variableInfo.seq == "ESC" || variableInfo.seq == "HEX" || variableInfo.seq == "OCT" || variableInfo.seq == "RAWHEX" || variableInfo.seq == "EMBED" || variableInfo.seq == "RAWHEX32" || variableInfo.seq == "RAWHEX64" || variableInfo.seq == "AUTO" || variableInfo.seq == "RAW"))
+    {
+        BOOST_LOG_TRIVIAL(fatal) << BLUE_COLOR << filename << RED_COLOR << " seq is not Correct has to be (ESC,HEX,OCT,RAWHEX,EMBED,RAWHEX32,RAWHEX64,AUTO,RAW)\nGiven seq: " << variableInfo.seq << RESET_COLOR << std::endl;
+        exit(1);
+    }
+    if (variableInfo.seq == "RAW" && parameterInfo.outputType == "c")
     {
-        BOOST_LOG_TRIVIAL(fatal) << BLUE_COLOR << filename << RED_COLOR << " seq is not Correct has to be (ESC,HEX,OCT,RAWHEX)\nGiven seq: " << variableInfo.seq << RESET_COLOR << std::endl;
+        BOOST_LOG_TRIVIAL(fatal) << BLUE_COLOR << filename << RED_COLOR << " seq RAW needs C++ output, raw string literals are not C\nVariable: " << variableInfo.name << RESET_COLOR << std::endl;
+        exit(1);
+    }
+    if (parameterInfo.packedBlob && isArraySeq(toSeqType(variableInfo.seq)))
+    {
+        BOOST_LOG_TRIVIAL(fatal) << BLUE_COLOR << filename << RED_COLOR << " seq " << variableInfo.seq << " can not be packed into the blob, it only holds strings\nVariable: " << variableInfo.name << RESET_COLOR << std::endl;
         exit(1);
     }
     variableInfo.content = variable["content"];
+
+    // Position of the content in the input file, if it was not kept in memory
+    variableInfo.contentOffset = variable["ContentOffset"].empty() ? 0 : std::stoll(variable["ContentOffset"]);
+    variableInfo.contentLength = variable["ContentLength"].empty() ? 0 : std::stoull(variable["ContentLength"]);
+    variableInfo.contentTail = variable["ContentTail"];
 }
 
 void GenTxtSrcCode::printExtraction(const std::map<std::string, std::string> &options, const std::vector<std::map<std::string, std::string>> &variables)
@@ -367,155 +489,1205 @@ void GenTxtSrcCode::printExtraction(const std::map<std::string, std::string> &op
     }
 }
 
-void GenTxtSrcCode::codeGeneration()
+std::unique_ptr<CTextToCPP> GenTxtSrcCode::createConverter(const VariableStruct &variable, const ParamStruct &parameter)
 {
-    if (optind < argc)
+    if (variable.seq == "ESC")
     {
-        try
-        {
-            for (int i = optind; i < argc; ++i)
-            {
-                std::string headerCode = "";
-                std::string sourceCode = "";
-                // This is where the magic happens
-                const std::string userInputFileName = argv[i];
-                const std::string inputFilePath = checkPath(PROJECT_PATH + "\\" + userInputFileName);
+        return std::make_unique<CTextToEscSeq>(variable, parameter);
+    }
+    else if (variable.seq == "HEX")
+    {
+        return std::make_unique<CTextToHexSeq>(variable, parameter);
+    }
+    else if (variable.seq == "OCT")
+    {
+        return std::make_unique<CTextToOctSeq>(variable, parameter);
+    }
+    else if (variable.seq == "AUTO")
+    {
+        return std::make_unique<CTextToAutoSeq>(variable, parameter);
+    }
+    else if (variable.seq == "RAW")
+    {
+        return std::make_unique<CTextToRawSeq>(variable, parameter);
+    }
+    // EMBED writes RAWHEX elements as fallback for compilers without #embed, RAWHEX32 and RAWHEX64 pack them into words
+    return std::make_unique<CTextToRawHexSeq>(variable, parameter);
+}
 
-                std::map<std::string, std::string> options;
-                std::vector<std::map<std::string, std::string>> variables;
-                std::vector<VariableStruct> variablesInfos;
+GenTxtSrcCode::FileJob GenTxtSrcCode::prepareFile(const std::string &userInputFileName)
+{
+    FileJob job;
+    job.inputFilePath = checkPath(PROJECT_PATH + "\\" + userInputFileName);
 
-                const std::filesystem::path filePath(inputFilePath);
-                const std::string inputFileName = filePath.stem().string();
+    std::map<std::string, std::string> options;
+    std::vector<std::map<std::string, std::string>> variables;
 
-                extractOptionsAndVariables(inputFilePath, options, variables);
-                checkOptions(options);
+    const std::filesystem::path filePath(job.inputFilePath);
+    job.inputFileName = filePath.stem().string();
 
-                for (std::map<std::string, std::string> &variable : variables)
-                {
-                    checkVariable(variable, inputFileName);
-                    variablesInfos.push_back(variableInfo);
-                }
+    // The contents stay in the input file and are read in chunks while converting
+    extractOptionsAndVariables(job.inputFilePath, options, variables, false);
+    checkOptions(options);
 
-                if (checkArgs == true)
-                {
-                    std::cout << BLUE_COLOR << inputFileName << " " << RESET_COLOR;
-                    printParamStruct(parameterInfo);
-                    std::cout << GREEN_COLOR << "Press any key to continue..." << RESET_COLOR << std::endl;
-                    getchar(); // Wait for any key
-                }
+    // isValidVariableName() gives a varname that is used again an index, so the names of the lookup are unique
+    for (std::map<std::string, std::string> &variable : variables)
+    {
+        checkVariable(variable, job.inputFileName);
+        variableInfo.sourceFile = job.inputFilePath;
+        job.variables.push_back(variableInfo);
+    }
 
-                // Start creating the Code
-                const std::string definitionName = "_" + toUpperCase(inputFileName) + "_";
-                headerCode.append("#ifndef " + definitionName + "\n");
-                headerCode.append("#define " + definitionName + "\n");
+    // the query of the outputs runs from build systems, it does not wait for a key
+    if (checkArgs == true && outputListFile.empty())
+    {
+        std::cout << BLUE_COLOR << job.inputFileName << " " << RESET_COLOR;
+        printParamStruct(parameterInfo);
+        std::cout << GREEN_COLOR << "Press any key to continue..." << RESET_COLOR << std::endl;
+        getchar(); // Wait for any key
+    }
 
-                sourceCode.append("#include <" + inputFileName + ".h>" + "\n\n");
+    // sort by variable Name if requested
+    // from A up
+    if (parameterInfo.sortByVarname)
+    {
+        std::cout << "I AM SORTING YAY" << std::endl;
+        std::sort(job.variables.begin(), job.variables.end(), [](const VariableStruct &a, const VariableStruct &b)
+                  { return a.name < b.name; });
+    }
 
-                if ((parameterInfo.outputType == "cpp") && !(parameterInfo.namespaceName.empty()))
-                {
-                    const std::string nameSpaceText = "namespace " + parameterInfo.namespaceName + "{\n";
-                    headerCode.append(nameSpaceText);
-                    sourceCode.append(nameSpaceText);
-                }
+    job.parameter = parameterInfo;
+    job.parameter.inputFileName = job.inputFileName;
+    return job;
+}
 
-                if ((variables.empty()))
-                {
-                    std::ifstream inputFile(inputFilePath);
-                    const std::string inputString((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
-                    variableInfo.content = inputString;
+std::filesystem::path GenTxtSrcCode::headerFilePath(const FileJob &job)
+{
+    return job.parameter.headerDir + "\\" + job.inputFileName + ".h";
+}
 
-                    headerCode.append("extern const char *const " + inputFileName + ";\n");
-                    sourceCode.append("extern const char *const " + inputFileName + " = {R\"(" + inputString + ")\"\n};");
-                }
+std::filesystem::path GenTxtSrcCode::sourceFilePath(const FileJob &job)
+{
+    return job.parameter.sourceDir + "\\" + job.inputFileName + "." + job.parameter.outputType;
+}
+
+CacheKey GenTxtSrcCode::outputKey(const FileJob &job)
+{
+    const ParamStruct &parameter = job.parameter;
+    CacheKey key;
+    key.addText("GenTxtSrcCode output " + std::to_string(OUTPUT_CACHE_VERSION));
+    key.addText(job.inputFileName);
+    key.addText(parameter.outputType == "S" ? std::filesystem::absolute(parameter.sourceDir).string() : "");
+    key.addText(parameter.outputType);
+    key.addText(parameter.outputFilename);
+    key.addText(parameter.namespaceName);
+    key.addText(std::to_string(parameter.signPerLine));
+    key.addText(std::to_string(parameter.sortByVarname));
+    key.addText(std::to_string(parameter.parallelThreshold));
+    key.addText(std::to_string(parameter.arrayDefinitions));
+    key.addText(std::to_string(parameter.packedBlob));
+    key.addText(std::to_string(parameter.nameLookup));
+    key.addText(std::to_string(parameter.variableCache));
+    for (const VariableStruct &variable : job.variables)
+    {
+        key.addText(variable.name);
+        key.addText(variable.seq);
+        key.addText(variable.nl);
+        key.addText(std::to_string(variable.VariableLineNumber));
+        key.addText(std::to_string(variable.addtextpos));
+        key.addText(std::to_string(variable.addtextsegment));
+        key.addText(variable.doxygen);
+    }
+
+    // with shared contents the code also depends on the other input files
+    for (const ContentAlias &alias : job.aliases)
+    {
+        key.addText(std::to_string(alias.target) + " " + std::to_string(alias.offset));
+    }
+    for (const std::pair<const std::size_t, ExternalAlias> &alias : job.externalAliases)
+    {
+        key.addText(std::to_string(alias.first) + " " + alias.second.targetNamespace + "::" + alias.second.targetName + " " + std::to_string(alias.second.offset));
+    }
+    for (const std::size_t exported : job.exportedContents)
+    {
+        key.addText(std::to_string(exported));
+    }
+
+    // the contents are read from the input file
+    FileRangeSource input(job.inputFilePath, 0, static_cast<std::size_t>(std::filesystem::file_size(job.inputFilePath)));
+    key.addSource(input);
+    return key;
+}
+
+GenTxtSrcCode::FileStatistics GenTxtSrcCode::generateCached(const FileJob &job)
+{
+    if (outputCache == nullptr)
+    {
+        return generateFile(job);
+    }
+
+    const CacheKey key = outputKey(job);
+    const std::filesystem::path headerPath = headerFilePath(job);
+    const std::filesystem::path sourcePath = sourceFilePath(job);
+    FileStatistics statistics;
+    if (outputCache->restore(key, headerPath.parent_path(), sourcePath.parent_path(), statistics.outputFiles, statistics.unchangedFiles))
+    {
+        statistics.restored = true;
+        statistics.variables = job.variables.size();
+        statistics.headerBytes = static_cast<std::size_t>(std::filesystem::file_size(headerPath));
+        statistics.sourceBytes = static_cast<std::size_t>(std::filesystem::file_size(sourcePath));
+        return statistics;
+    }
 
-                // sort by variable Name if requested
-                // from A up
-                if (parameterInfo.sortByVarname)
+    statistics = generateFile(job);
+    std::vector<std::filesystem::path> sourceFiles;
+    for (const std::filesystem::path &file : statistics.outputFiles)
+    {
+        if (file != headerPath)
+        {
+            sourceFiles.push_back(file);
+        }
+    }
+    outputCache->store(key, headerPath, sourceFiles);
+    return statistics;
+}
+
+void GenTxtSrcCode::shareContentsAcrossFiles(std::deque<FileJob> &fileJobs)
+{
+    for (const std::string outputType : {"c", "cpp"})
+    {
+        // the same rules as in findAliases(), every source remembers its file and variable
+        std::vector<std::unique_ptr<CTextToCPP>> converters;
+        std::vector<std::unique_ptr<ByteSource>> shareable;
+        std::vector<std::pair<std::size_t, std::size_t>> owners;
+        for (std::size_t file = 0; file < fileJobs.size(); file++)
+        {
+            FileJob &job = fileJobs[file];
+            const ParamStruct &parameter = job.parameter;
+            if (parameter.outputType != outputType || parameter.arrayDefinitions || parameter.packedBlob)
+            {
+                continue;
+            }
+            job.aliases.clear();
+            for (std::size_t i = 0; i < job.variables.size(); i++)
+            {
+                job.aliases.push_back({i, 0});
+                if (!isArraySeq(toSeqType(job.variables[i].seq)))
                 {
-                    std::cout << "I AM SORTING YAY" << std::endl;
-                    std::sort(variablesInfos.begin(), variablesInfos.end(), [](const VariableStruct &a, const VariableStruct &b)
-                              { return a.name < b.name; });
+                    converters.push_back(createConverter(job.variables[i], parameter));
+                    shareable.push_back(converters.back()->openContent());
+                    owners.emplace_back(file, i);
                 }
+            }
+        }
+
+        const std::vector<ContentAlias> aliases = findContentAliases(shareable);
+        for (std::size_t k = 0; k < aliases.size(); k++)
+        {
+            const std::pair<std::size_t, std::size_t> &owner = owners[k];
+            const std::pair<std::size_t, std::size_t> &target = owners[aliases[k].target];
+            FileJob &job = fileJobs[owner.first];
+            if (aliases[k].target == k || job.variables[owner.second].addtextsegment)
+            {
+                continue;
+            }
+            if (target.first == owner.first)
+            {
+                job.aliases[owner.second] = {target.second, aliases[k].offset};
+                continue;
+            }
+            FileJob &targetJob = fileJobs[target.first];
+            job.externalAliases[owner.second] = {targetJob.variables[target.second].name,
+                                                 targetJob.parameter.namespaceName, aliases[k].offset};
+            targetJob.exportedContents.insert(target.second);
+        }
+    }
+}
+
+std::vector<ContentAlias> GenTxtSrcCode::findAliases(const FileJob &job, const std::vector<std::shared_ptr<CTextToCPP>> &converters)
+{
+    if (!job.aliases.empty())
+    {
+        return job.aliases;
+    }
+
+    // Arrays have no terminator to share and the comment with the original text needs a definition of its own,
+    // except in the blob, where the comments follow it
+    const ParamStruct &parameter = job.parameter;
+    std::vector<std::unique_ptr<ByteSource>> shareable;
+    for (std::size_t i = 0; i < job.variables.size(); i++)
+    {
+        const bool isString = !isArraySeq(toSeqType(job.variables[i].seq)) && (parameter.packedBlob || !parameter.arrayDefinitions);
+        shareable.push_back(isString ? converters[i]->openContent() : nullptr);
+    }
+    std::vector<ContentAlias> aliases = findContentAliases(shareable);
+    for (std::size_t i = 0; i < aliases.size(); i++)
+    {
+        if (aliases[i].target != i && job.variables[i].addtextsegment && !parameter.packedBlob)
+        {
+            aliases[i] = {i, 0};
+        }
+    }
+    return aliases;
+}
+
+std::vector<std::filesystem::path> GenTxtSrcCode::outputFiles(const FileJob &job)
+{
+    const ParamStruct &parameter = job.parameter;
+    const std::filesystem::path sourceFilePath = GenTxtSrcCode::sourceFilePath(job);
+    std::vector<std::filesystem::path> files = {headerFilePath(job)};
+
+    if (parameter.packedBlob && !job.variables.empty())
+    {
+        if (parameter.outputType == "S")
+        {
+            files.push_back(std::filesystem::absolute(parameter.sourceDir + "\\" + job.inputFileName + "_blob.bin"));
+        }
+    }
+    else if (parameter.outputType == "S")
+    {
+        // every variable that holds its own content gets a sidecar file, only here the contents are compared
+        const auto sidecarPath = [&](const std::string &name)
+        {
+            return std::filesystem::absolute(parameter.sourceDir + "\\" + job.inputFileName + "_" + name + ".bin");
+        };
+        if (job.variables.empty())
+        {
+            files.push_back(sidecarPath(job.inputFileName));
+        }
+        std::vector<std::shared_ptr<CTextToCPP>> converters;
+        for (const VariableStruct &variable : job.variables)
+        {
+            converters.push_back(createConverter(variable, parameter));
+        }
+        const std::vector<ContentAlias> aliases = findAliases(job, converters);
+        for (std::size_t i = 0; i < job.variables.size(); i++)
+        {
+            if (aliases[i].target == i)
+            {
+                files.push_back(sidecarPath(job.variables[i].name));
+            }
+        }
+    }
+    else if (parameter.outputType != "o")
+    {
+        for (const VariableStruct &variable : job.variables)
+        {
+            if (toSeqType(variable.seq) == SeqType::EMBED)
+            {
+                files.push_back(createConverter(variable, parameter)->embedFilePath());
+            }
+        }
+        if (parameter.variableCache)
+        {
+            files.push_back(sourceFilePath.string() + ".cache");
+        }
+    }
+    files.push_back(sourceFilePath);
+    return files;
+}
+
+GenTxtSrcCode::FileStatistics GenTxtSrcCode::generateFile(const FileJob &job)
+{
+    const ParamStruct &parameter = job.parameter;
+    const std::string &inputFileName = job.inputFileName;
+    FileStatistics statistics;
+    statistics.variables = job.variables.size();
+
+    // The header is collected in parts and joined into a buffer of its exact size at the end
+    std::vector<std::string> headerParts;
+
+    // All contents are checked before anything is written, every non ASCII character is reported at once
+    std::vector<std::shared_ptr<CTextToCPP>> converters;
+    std::string asciiErrors;
+    std::size_t asciiErrorCount = 0;
+    for (const struct VariableStruct &variable : job.variables)
+    {
+        converters.push_back(createConverter(variable, parameter));
+        for (const AsciiError &error : converters.back()->checkContent())
+        {
+            asciiErrors.append("\n" + describeAsciiError(error, job.inputFilePath));
+            asciiErrorCount++;
+        }
+    }
+    if (asciiErrorCount > 0)
+    {
+        throw std::runtime_error(std::to_string(asciiErrorCount) + " non ASCII characters in " + inputFileName + asciiErrors);
+    }
+
+    // Equal contents and contents that end another one are written once, the other variables point into them
+    const std::vector<ContentAlias> aliases = findAliases(job, converters);
+    for (std::size_t i = 0; i < aliases.size(); i++)
+    {
+        if (aliases[i].target != i)
+        {
+            // in the blob an alias is only an offset
+            if (!parameter.packedBlob)
+            {
+                converters[aliases[i].target]->shareContent();
+            }
+            statistics.aliases++;
+        }
+    }
+    for (const std::size_t exported : job.exportedContents)
+    {
+        converters[exported]->exportContent();
+    }
+    statistics.aliases += job.externalAliases.size();
+
+    const std::filesystem::path headerFilePath = GenTxtSrcCode::headerFilePath(job);
+    const std::filesystem::path sourceFilePath = GenTxtSrcCode::sourceFilePath(job);
+
+    std::filesystem::create_directories(headerFilePath.parent_path());
+    std::filesystem::create_directories(sourceFilePath.parent_path());
+
+    // Start creating the Code
+    const std::string definitionName = "_" + toUpperCase(inputFileName) + "_";
+    headerParts.push_back("#ifndef " + definitionName + "\n");
+    headerParts.push_back("#define " + definitionName + "\n");
+
+    // the packed arrays and the lookup use the fixed width integer types, the size constants and the tables size_t,
+    // the assembler output declares a size for every variable
+    bool sizeConstants = parameter.arrayDefinitions || parameter.packedBlob || parameter.nameLookup || parameter.outputType == "S";
+    for (const std::shared_ptr<CTextToCPP> &converter : converters)
+    {
+        sizeConstants = sizeConstants || converter->hasSizeConstant();
+    }
+    if (sizeConstants)
+    {
+        headerParts.push_back("#include <stddef.h>\n#include <stdint.h>\n");
+    }
+
+    if (parameter.packedBlob && !job.variables.empty())
+    {
+        writeBlobFile(job, converters, aliases, sourceFilePath, headerParts, statistics);
+    }
+    else if (parameter.outputType == "o")
+    {
+        writeObjectFile(job, converters, aliases, sourceFilePath, headerParts, statistics);
+    }
+    else if (parameter.outputType == "S")
+    {
+        writeIncbinFile(job, converters, aliases, sourceFilePath, headerParts, statistics);
+    }
+    else
+    {
+        writeSourceFile(job, converters, aliases, sourceFilePath, headerParts, statistics);
+    }
+    if (parameter.nameLookup && !job.variables.empty())
+    {
+        headerParts.push_back(writeLookup(job, converters));
+    }
+    headerParts.push_back("#endif");
+
+    std::size_t headerSize = 0;
+    for (const std::string &part : headerParts)
+    {
+        headerSize += part.size();
+    }
+    std::string headerCode;
+    StringSink headerSink(headerCode, headerSize);
+    for (const std::string &part : headerParts)
+    {
+        headerSink.write(part);
+    }
+    statistics.headerBytes = headerCode.size();
+    statistics.buffers++;
+    statistics.allocations += headerSink.allocations();
+
+    // Write to the files, a file that already has the content keeps its timestamp
+    OutputFile headerFile(headerFilePath);
+    headerFile.stream().write(headerCode.data(), static_cast<std::streamsize>(headerCode.size()));
+    if (!headerFile.commit())
+    {
+        statistics.unchangedFiles++;
+    }
+    statistics.outputFiles.push_back(headerFilePath);
+    return statistics;
+}
+
+void GenTxtSrcCode::writeSourceFile(const FileJob &job, const std::vector<std::shared_ptr<CTextToCPP>> &converters,
+                                    const std::vector<ContentAlias> &aliases,
+                                    const std::filesystem::path &sourceFilePath, std::vector<std::string> &headerParts,
+                                    FileStatistics &statistics)
+{
+    const ParamStruct &parameter = job.parameter;
+    const std::string &inputFileName = job.inputFileName;
+
+    // The source is written while converting, so the converted variables are never in memory as a whole.
+    // With the cache it is written in binary mode, the positions in the index are the bytes that are copied back
+    OutputFile sourceFile(sourceFilePath, parameter.variableCache);
+    StreamSink sourceCode(sourceFile.stream());
+
+    // the variables that did not change are copied from the previous source, its index is read first
+    std::unique_ptr<VariableCache> cache;
+    if (parameter.variableCache)
+    {
+        cache = std::make_unique<VariableCache>(sourceFilePath);
+    }
+    const auto recordCode = [&](const bool cached, const std::uint64_t key, const std::streamoff begin)
+    {
+        if (cached)
+        {
+            cache->record(key, static_cast<std::size_t>(begin), static_cast<std::size_t>(sourceFile.stream().tellp() - begin));
+        }
+    };
+
+    sourceCode.write("#include <" + inputFileName + ".h>" + "\n\n");
+
+    // the contents of other files are declared in the namespaces of their files
+    std::set<std::string> declaredContents;
+    for (const std::pair<const std::size_t, ExternalAlias> &alias : job.externalAliases)
+    {
+        const std::string &targetNamespace = alias.second.targetNamespace;
+        const std::string declaration = "extern const char " + alias.second.targetName + "_content[];";
+        if (!declaredContents.insert(targetNamespace + "::" + alias.second.targetName).second)
+        {
+            continue;
+        }
+        if (parameter.outputType == "cpp" && !targetNamespace.empty())
+        {
+            sourceCode.write("namespace " + targetNamespace + " { " + declaration + " }\n");
+        }
+        else
+        {
+            sourceCode.write(declaration + "\n");
+        }
+    }
+    if (!declaredContents.empty())
+    {
+        sourceCode.write("\n");
+    }
+
+    if ((parameter.outputType == "cpp") && !(parameter.namespaceName.empty()))
+    {
+        const std::string nameSpaceText = "namespace " + parameter.namespaceName + "{\n";
+        headerParts.push_back(nameSpaceText);
+        sourceCode.write(nameSpaceText);
+    }
 
-                for (const struct VariableStruct &variable : variablesInfos)
+    if ((job.variables.empty()))
+    {
+        const std::string definitionHead = parameter.arrayDefinitions ? "const char " + inputFileName + "[]"
+                                                                       : "const char *const " + inputFileName;
+        const std::size_t fileSize = static_cast<std::size_t>(std::filesystem::file_size(job.inputFilePath));
+        headerParts.push_back("extern " + definitionHead + ";\n");
+        if (parameter.arrayDefinitions)
+        {
+            headerParts.push_back(CTextToCPP::sizeConstant(inputFileName, fileSize));
+        }
+
+        // the delimiter of the raw string must not occur in the file
+        FileRangeSource scanned(job.inputFilePath, 0, fileSize);
+        const std::string delimiter = CTextToRawSeq::findDelimiter(scanned);
+        sourceCode.write("extern " + definitionHead + " = {R\"" + delimiter + "(");
+
+        // copy the whole input file in chunks
+        std::ifstream inputFile(job.inputFilePath);
+        std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+        while (inputFile.read(buffer.data(), buffer.size()) || inputFile.gcount() > 0)
+        {
+            sourceCode.write(buffer.data(), static_cast<std::size_t>(inputFile.gcount()));
+            statistics.inputBytes += static_cast<std::size_t>(inputFile.gcount());
+        }
+        sourceCode.write(")" + delimiter + "\"\n};");
+    }
+
+    // Small variables are converted on the pool into buffers of their own and written in order,
+    // a variable above the parallel threshold is converted in parallel blocks straight into the file
+    struct ConvertedVariable
+    {
+        std::string text;        /**< Source text of the variable */
+        std::size_t allocations; /**< Allocations of text while it was written */
+        bool cached;             /**< The code goes into the index of the cache */
+        std::uint64_t key;       /**< Key of the variable in the cache */
+    };
+    ThreadPool &pool = ThreadPool::shared();
+    const std::size_t maxQueued = 2 * pool.size();
+    std::deque<std::future<ConvertedVariable>> converted;
+    const auto writeConverted = [&](const std::size_t keep)
+    {
+        while (converted.size() > keep)
+        {
+            const ConvertedVariable variable = pool.wait(converted.front());
+            const std::streamoff begin = sourceFile.stream().tellp();
+            sourceCode.write(variable.text);
+            recordCode(variable.cached, variable.key, begin);
+            statistics.buffers++;
+            statistics.allocations += variable.allocations;
+            converted.pop_front();
+        }
+    };
+
+    std::string aliasDefinitions;
+    for (std::size_t i = 0; i < job.variables.size(); i++)
+    {
+        const struct VariableStruct &variable = job.variables[i];
+        const std::shared_ptr<CTextToCPP> &converter = converters[i];
+        headerParts.push_back(converter->writeDeclaration());
+
+        const std::size_t contentSize = variable.sourceFile.empty() ? variable.content.size() : variable.contentLength;
+        statistics.inputBytes += contentSize;
+        const auto external = job.externalAliases.find(i);
+        if (external != job.externalAliases.end())
+        {
+            // qualified, as the namespace of the other file can differ
+            std::string targetName = external->second.targetName;
+            if (parameter.outputType == "cpp")
+            {
+                const std::string &targetNamespace = external->second.targetNamespace;
+                targetName = (targetNamespace.rfind("::", 0) == 0 ? "" : "::") + targetNamespace + (targetNamespace.empty() ? "" : "::") + targetName;
+            }
+            aliasDefinitions.append(converter->writeAliasDefinition(targetName, external->second.offset));
+            continue;
+        }
+        if (aliases[i].target != i)
+        {
+            // defined after all variables, when the content it points into is defined
+            aliasDefinitions.append(converter->writeAliasDefinition(job.variables[aliases[i].target].name, aliases[i].offset));
+            continue;
+        }
+
+        // EMBED also writes its binary file, so it is always converted
+        const bool cached = cache != nullptr && toSeqType(variable.seq) != SeqType::EMBED;
+        if (toSeqType(variable.seq) == SeqType::EMBED)
+        {
+            statistics.outputFiles.push_back(converter->embedFilePath());
+        }
+        const std::uint64_t key = cached ? converter->implementationKey() : 0;
+        if (cached && cache->contains(key))
+        {
+            writeConverted(0);
+            const std::streamoff begin = sourceFile.stream().tellp();
+            cache->copy(key, sourceCode);
+            recordCode(cached, key, begin);
+            statistics.cachedVariables++;
+        }
+        else if (pool.size() <= 1 || (parameter.parallelThreshold > 0 && contentSize >= parameter.parallelThreshold))
+        {
+            writeConverted(0);
+            const std::streamoff begin = sourceFile.stream().tellp();
+            converter->writeImplementation(sourceCode);
+            recordCode(cached, key, begin);
+        }
+        else
+        {
+            // the exact size is counted first, so the buffer is allocated once
+            converted.push_back(pool.submit([converter, cached, key]()
+                                            {
+                                                ConvertedVariable result;
+                                                result.cached = cached;
+                                                result.key = key;
+                                                StringSink sink(result.text, converter->implementationSize());
+                                                converter->writeImplementation(sink);
+                                                result.allocations = sink.allocations();
+                                                return result; }));
+            writeConverted(maxQueued);
+        }
+    }
+    writeConverted(0);
+    sourceCode.write(aliasDefinitions);
+
+    if ((parameter.outputType == "cpp") && !(parameter.namespaceName.empty()))
+    {
+        const std::string nameSpaceText = "}\n";
+        headerParts.push_back(nameSpaceText);
+        sourceCode.write(nameSpaceText);
+    }
+    statistics.sourceBytes = static_cast<std::size_t>(sourceFile.stream().tellp());
+    if (!(cache != nullptr ? cache->commit(sourceFile) : sourceFile.commit()))
+    {
+        statistics.unchangedFiles++;
+    }
+    statistics.outputFiles.push_back(sourceFilePath);
+}
+
+void GenTxtSrcCode::writeObjectFile(const FileJob &job, const std::vector<std::shared_ptr<CTextToCPP>> &converters,
+                                    const std::vector<ContentAlias> &aliases,
+                                    const std::filesystem::path &objectFilePath, std::vector<std::string> &headerParts,
+                                    FileStatistics &statistics)
+{
+    // The object file defines the variables with C linkage, so the header declares them extern "C"
+    headerParts.push_back("#ifdef __cplusplus\nextern \"C\" {\n#endif\n");
+
+    ElfObjectWriter object;
+    if (job.variables.empty())
+    {
+        const std::size_t fileSize = static_cast<std::size_t>(std::filesystem::file_size(job.inputFilePath));
+        std::unique_ptr<ByteSource> content = std::make_unique<FileRangeSource>(job.inputFilePath, 0, fileSize);
+        if (job.parameter.arrayDefinitions)
+        {
+            headerParts.push_back("extern const char " + job.inputFileName + "[];\n");
+            headerParts.push_back(CTextToCPP::sizeConstant(job.inputFileName, fileSize));
+            object.addStringArray(job.inputFileName, std::move(content));
+        }
+        else
+        {
+            headerParts.push_back("extern const char *const " + job.inputFileName + ";\n");
+            object.addString(job.inputFileName, std::move(content));
+        }
+        statistics.inputBytes += fileSize;
+    }
+
+    // the contents are copied as they are, nothing has to be converted
+    for (std::size_t i = 0; i < job.variables.size(); i++)
+    {
+        const struct VariableStruct &variable = job.variables[i];
+        headerParts.push_back(converters[i]->writeDeclaration(true));
+
+        std::unique_ptr<ByteSource> content = converters[i]->openContent();
+        statistics.inputBytes += content->size();
+        const SeqType seqType = toSeqType(variable.seq);
+        if (aliases[i].target != i)
+        {
+            object.addStringAlias(variable.name, job.variables[aliases[i].target].name, aliases[i].offset);
+        }
+        else if (isArraySeq(seqType))
+        {
+            object.addArray(variable.name, std::move(content), seqWordSize(seqType));
+        }
+        else if (job.parameter.arrayDefinitions)
+        {
+            object.addStringArray(variable.name, std::move(content));
+        }
+        else
+        {
+            object.addString(variable.name, std::move(content));
+        }
+    }
+    headerParts.push_back("#ifdef __cplusplus\n}\n#endif\n");
+
+    OutputFile objectFile(objectFilePath, true);
+    StreamSink objectSink(objectFile.stream());
+    statistics.sourceBytes = object.write(objectSink);
+    if (!objectFile.commit())
+    {
+        statistics.unchangedFiles++;
+    }
+    statistics.outputFiles.push_back(objectFilePath);
+}
+
+void GenTxtSrcCode::writeIncbinFile(const FileJob &job, const std::vector<std::shared_ptr<CTextToCPP>> &converters,
+                                    const std::vector<ContentAlias> &aliases,
+                                    const std::filesystem::path &assemblerFilePath, std::vector<std::string> &headerParts,
+                                    FileStatistics &statistics)
+{
+    const ParamStruct &parameter = job.parameter;
+
+    // The assembler file defines the variables with C linkage, so the header declares them extern "C"
+    headerParts.push_back("#ifdef __cplusplus\nextern \"C\" {\n#endif\n");
+
+    // every content goes to a binary file next to the assembler file, it is included by its absolute path
+    IncbinWriter assembler;
+    const auto sidecarPath = [&](const std::string &name)
+    {
+        return std::filesystem::absolute(parameter.sourceDir + "\\" + job.inputFileName + "_" + name + ".bin");
+    };
+
+    if (job.variables.empty())
+    {
+        const std::size_t fileSize = static_cast<std::size_t>(std::filesystem::file_size(job.inputFilePath));
+        FileRangeSource content(job.inputFilePath, 0, fileSize);
+        const std::filesystem::path binaryPath = sidecarPath(job.inputFileName);
+        if (!copyToFile(content, binaryPath.string()))
+        {
+            statistics.unchangedFiles++;
+        }
+        statistics.outputFiles.push_back(binaryPath);
+        if (parameter.arrayDefinitions)
+        {
+            headerParts.push_back("extern const char " + job.inputFileName + "[];\n");
+            headerParts.push_back(CTextToCPP::sizeConstant(job.inputFileName, fileSize));
+            assembler.addStringArray(job.inputFileName, binaryPath.generic_string(), fileSize);
+        }
+        else
+        {
+            headerParts.push_back("extern const char *const " + job.inputFileName + ";\n");
+            headerParts.push_back(IncbinWriter::sizeDeclaration(job.inputFileName));
+            assembler.addString(job.inputFileName, binaryPath.generic_string(), fileSize);
+        }
+        statistics.inputBytes += fileSize;
+    }
+
+    for (std::size_t i = 0; i < job.variables.size(); i++)
+    {
+        const struct VariableStruct &variable = job.variables[i];
+        const SeqType seqType = toSeqType(variable.seq);
+        headerParts.push_back(converters[i]->writeDeclaration(true));
+        // the declaration already has the size as constant for packed arrays and array definitions
+        if (!converters[i]->hasSizeConstant())
+        {
+            headerParts.push_back(IncbinWriter::sizeDeclaration(variable.name));
+        }
+
+        const std::unique_ptr<ByteSource> content = converters[i]->openContent();
+        statistics.inputBytes += content->size();
+        if (aliases[i].target != i)
+        {
+            // the content is in the sidecar file of the target
+            assembler.addStringAlias(variable.name, job.variables[aliases[i].target].name, aliases[i].offset, content->size());
+            continue;
+        }
+
+        const std::filesystem::path binaryPath = sidecarPath(variable.name);
+        if (!copyToFile(*content, binaryPath.string()))
+        {
+            statistics.unchangedFiles++;
+        }
+        statistics.outputFiles.push_back(binaryPath);
+        if (isArraySeq(seqType))
+        {
+            assembler.addArray(variable.name, binaryPath.generic_string(), content->size(), seqWordSize(seqType));
+        }
+        else if (parameter.arrayDefinitions)
+        {
+            assembler.addStringArray(variable.name, binaryPath.generic_string(), content->size());
+        }
+        else
+        {
+            assembler.addString(variable.name, binaryPath.generic_string(), content->size());
+        }
+    }
+    headerParts.push_back("#ifdef __cplusplus\n}\n#endif\n");
+
+    OutputFile assemblerFile(assemblerFilePath);
+    StreamSink assemblerSink(assemblerFile.stream());
+    assembler.write(assemblerSink);
+    statistics.sourceBytes = static_cast<std::size_t>(assemblerFile.stream().tellp());
+    if (!assemblerFile.commit())
+    {
+        statistics.unchangedFiles++;
+    }
+    statistics.outputFiles.push_back(assemblerFilePath);
+}
+
+void GenTxtSrcCode::writeBlobFile(const FileJob &job, const std::vector<std::shared_ptr<CTextToCPP>> &converters,
+                                  const std::vector<ContentAlias> &aliases,
+                                  const std::filesystem::path &sourceFilePath, std::vector<std::string> &headerParts,
+                                  FileStatistics &statistics)
+{
+    const ParamStruct &parameter = job.parameter;
+    const std::string blobName = job.inputFileName + "_blob";
+    const bool cLinkage = parameter.outputType == "o" || parameter.outputType == "S";
+    const bool useNamespace = parameter.outputType == "cpp" && !parameter.namespaceName.empty();
+
+    // the contents are laid out in the order of the variables, an alias gets the position in its target, the file
+    // ranges of the contents are only opened while the blob reads them
+    static const std::string terminator(1, '\0');
+    std::vector<std::size_t> offsets(job.variables.size());
+    std::vector<std::unique_ptr<ByteSource>> parts;
+    std::size_t blobSize = 0;
+    for (std::size_t i = 0; i < job.variables.size(); i++)
+    {
+        std::unique_ptr<ByteSource> content = converters[i]->openContent();
+        statistics.inputBytes += content->size();
+        if (aliases[i].target == i)
+        {
+            offsets[i] = blobSize;
+            blobSize += content->size() + 1;
+            parts.push_back(std::move(content));
+            parts.push_back(std::make_unique<StringSource>(terminator));
+        }
+    }
+    for (std::size_t i = 0; i < job.variables.size(); i++)
+    {
+        offsets[i] = offsets[aliases[i].target] + aliases[i].offset;
+    }
+
+    if (cLinkage)
+    {
+        headerParts.push_back("#ifdef __cplusplus\nextern \"C\" {\n#endif\n");
+    }
+    if (useNamespace)
+    {
+        headerParts.push_back("namespace " + parameter.namespaceName + "{\n");
+    }
+    headerParts.push_back("typedef struct\n{\n    size_t offset;\n    size_t size;\n} " + job.inputFileName + "_entry;\n");
+    headerParts.push_back("extern const char " + blobName + "[];\n");
+    headerParts.push_back("static const size_t " + job.inputFileName + "_count = " + std::to_string(job.variables.size()) + ";\n");
+    std::string table = "static const " + job.inputFileName + "_entry " + job.inputFileName + "_table[] = {\n";
+    for (std::size_t i = 0; i < job.variables.size(); i++)
+    {
+        table.append("    {" + std::to_string(offsets[i]) + ", " + std::to_string(converters[i]->openContent()->size()) + "},\n");
+    }
+    headerParts.push_back(table + "};\n");
+    for (std::size_t i = 0; i < job.variables.size(); i++)
+    {
+        headerParts.push_back(converters[i]->writeBlobAccessor(blobName, offsets[i]));
+    }
+    if (useNamespace)
+    {
+        headerParts.push_back("}\n");
+    }
+    if (cLinkage)
+    {
+        headerParts.push_back("#ifdef __cplusplus\n}\n#endif\n");
+    }
+
+    // the object and the assembler file align the blob for the cache, a source leaves it to the compiler
+    constexpr std::size_t blobAlignment = 16;
+    if (parameter.outputType == "o")
+    {
+        ElfObjectWriter object;
+        object.addArray(blobName, std::make_unique<ConcatSource>(std::move(parts)), blobAlignment);
+
+        OutputFile objectFile(sourceFilePath, true);
+        StreamSink objectSink(objectFile.stream());
+        statistics.sourceBytes = object.write(objectSink);
+        if (!objectFile.commit())
+        {
+            statistics.unchangedFiles++;
+        }
+        statistics.outputFiles.push_back(sourceFilePath);
+        return;
+    }
+    if (parameter.outputType == "S")
+    {
+        const std::filesystem::path binaryPath = std::filesystem::absolute(parameter.sourceDir + "\\" + blobName + ".bin");
+        ConcatSource blob(std::move(parts));
+        if (!copyToFile(blob, binaryPath.string()))
+        {
+            statistics.unchangedFiles++;
+        }
+        statistics.outputFiles.push_back(binaryPath);
+
+        IncbinWriter assembler;
+        assembler.addArray(blobName, binaryPath.generic_string(), blobSize, blobAlignment);
+
+        OutputFile assemblerFile(sourceFilePath);
+        StreamSink assemblerSink(assemblerFile.stream());
+        assembler.write(assemblerSink);
+        statistics.sourceBytes = static_cast<std::size_t>(assemblerFile.stream().tellp());
+        if (!assemblerFile.commit())
+        {
+            statistics.unchangedFiles++;
+        }
+        statistics.outputFiles.push_back(sourceFilePath);
+        return;
+    }
+
+    OutputFile sourceFile(sourceFilePath);
+    StreamSink sourceCode(sourceFile.stream());
+
+    // the declaration in the header gives the blob external linkage in C++ as well
+    sourceCode.write("#include <" + job.inputFileName + ".h>" + "\n\n");
+    if (useNamespace)
+    {
+        sourceCode.write("namespace " + parameter.namespaceName + "{\n");
+    }
+    sourceCode.write("const char " + blobName + "[] = {\n");
+    for (std::size_t i = 0; i < job.variables.size(); i++)
+    {
+        if (aliases[i].target == i)
+        {
+            converters[i]->writeContent(sourceCode);
+            sourceCode.write("\"\\0\"\n", 5);
+        }
+    }
+    sourceCode.write("};\n", 3);
+    for (const std::shared_ptr<CTextToCPP> &converter : converters)
+    {
+        converter->writeTextSegment(sourceCode);
+    }
+    if (useNamespace)
+    {
+        sourceCode.write("}\n", 2);
+    }
+    statistics.sourceBytes = static_cast<std::size_t>(sourceFile.stream().tellp());
+    if (!sourceFile.commit())
+    {
+        statistics.unchangedFiles++;
+    }
+    statistics.outputFiles.push_back(sourceFilePath);
+}
+
+std::string GenTxtSrcCode::writeLookup(const FileJob &job, const std::vector<std::shared_ptr<CTextToCPP>> &converters)
+{
+    const ParamStruct &parameter = job.parameter;
+    const std::string &prefix = job.inputFileName;
+    const bool useNamespace = parameter.outputType == "cpp" && !parameter.namespaceName.empty();
+
+    std::vector<std::string> names;
+    for (const struct VariableStruct &variable : job.variables)
+    {
+        names.push_back(variable.name);
+    }
+    const PerfectHash hash = buildPerfectHash(names);
+    const auto writeTable = [](const std::string &tableName, const std::vector<std::uint32_t> &values)
+    {
+        std::string table = "static const uint32_t " + tableName + "[] = {";
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            table.append((i % 16 == 0 ? "\n    " : " ") + std::to_string(values[i]) + ",");
+        }
+        return table + "\n};\n";
+    };
+
+    std::string code = "#include <string.h>\n#if defined(__cplusplus) && __cplusplus >= 201703L\n#include <string_view>\n#endif\n";
+    if (useNamespace)
+    {
+        code.append("namespace " + parameter.namespaceName + "{\n");
+    }
+    code.append("typedef struct\n{\n    const char *data;\n    size_t size;\n} " + prefix + "_resource;\n");
+
+    // the names follow each other without terminator, offset and length find them
+    std::vector<std::uint32_t> nameOffsets;
+    std::vector<std::uint32_t> nameLengths;
+    code.append("static const char " + prefix + "_names[] =");
+    std::uint32_t nameOffset = 0;
+    for (const std::string &name : names)
+    {
+        code.append("\n    \"" + name + "\"");
+        nameOffsets.push_back(nameOffset);
+        nameLengths.push_back(static_cast<std::uint32_t>(name.size()));
+        nameOffset += static_cast<std::uint32_t>(name.size());
+    }
+    code.append(";\n");
+    code.append(writeTable(prefix + "_nameOffsets", nameOffsets));
+    code.append(writeTable(prefix + "_nameLengths", nameLengths));
+    code.append(writeTable(prefix + "_displacements", hash.displacements));
+    code.append(writeTable(prefix + "_slots", hash.slots));
+    code.append(writeHashFunction(prefix + "_hash"));
+
+    const std::string bucketMask = std::to_string(hash.displacements.size() - 1) + "u";
+    const std::string slotMask = std::to_string(hash.slots.size() - 1) + "u";
+    code.append("static inline " + prefix + "_resource " + prefix + "_lookup(const char *name, size_t length)\n{\n");
+    code.append("    const uint32_t displacement = " + prefix + "_displacements[" + prefix + "_hash(name, length, 0) & " + bucketMask + "];\n");
+    code.append("    const uint32_t index = " + prefix + "_slots[" + prefix + "_hash(name, length, displacement) & " + slotMask + "];\n");
+    code.append("    " + prefix + "_resource resource = {NULL, 0};\n");
+    code.append("    if (length != " + prefix + "_nameLengths[index] || memcmp(" + prefix + "_names + " + prefix + "_nameOffsets[index], name, length) != 0)\n");
+    code.append("    {\n        return resource;\n    }\n");
+
+    // the variables are not constant expressions in C, so they are read in a switch instead of a table
+    code.append("    switch (index)\n    {\n");
+    for (std::size_t i = 0; i < job.variables.size(); i++)
+    {
+        const struct VariableStruct &variable = job.variables[i];
+        std::string data = variable.name;
+        if (parameter.packedBlob)
+        {
+            data.append("()");
+        }
+        else if (isArraySeq(toSeqType(variable.seq)))
+        {
+            data = "(const char *)" + data;
+        }
+        code.append("    case " + std::to_string(i) + ":\n");
+        code.append("        resource.data = " + data + ";\n");
+        code.append("        resource.size = " + std::to_string(converters[i]->openContent()->size()) + ";\n");
+        code.append("        break;\n");
+    }
+    code.append("    }\n    return resource;\n}\n");
+
+    code.append("#if defined(__cplusplus) && __cplusplus >= 201703L\n");
+    code.append("static inline " + prefix + "_resource " + prefix + "_lookup(std::string_view name)\n{\n");
+    code.append("    return " + prefix + "_lookup(name.data(), name.size());\n}\n#endif\n");
+    if (useNamespace)
+    {
+        code.append("}\n");
+    }
+    return code;
+}
+
+void GenTxtSrcCode::logStatistics(const std::string &inputFileName, const FileStatistics &statistics)
+{
+    BOOST_LOG_TRIVIAL(info) << "Statistics for file: " << inputFileName << " variables: " << statistics.variables
+                            << " input bytes: " << statistics.inputBytes << " header bytes: " << statistics.headerBytes
+                            << " source bytes: " << statistics.sourceBytes << " buffers: " << statistics.buffers
+                            << " allocations: " << statistics.allocations << " aliases: " << statistics.aliases
+                            << " unchanged files: " << statistics.unchangedFiles
+                            << " cached variables: " << statistics.cachedVariables
+                            << " restored: " << statistics.restored << std::endl;
+}
+
+void GenTxtSrcCode::writeDepFile(const std::vector<std::filesystem::path> &outputs, const std::vector<std::filesystem::path> &inputs)
+{
+    // the input paths have doubled separators, make and ninja read forward slashes on every system
+    std::vector<std::string> targets;
+    for (const std::filesystem::path &output : outputs)
+    {
+        targets.push_back(output.lexically_normal().generic_string());
+    }
+    if (!depTarget.empty())
+    {
+        targets = {std::filesystem::path(depTarget).lexically_normal().generic_string()};
+    }
+    std::vector<std::string> prerequisites;
+    for (const std::filesystem::path &input : inputs)
+    {
+        prerequisites.push_back(input.lexically_normal().generic_string());
+    }
+
+    OutputFile file(depFile);
+    file.stream() << writeMakeRule(targets, prerequisites);
+    file.commit();
+}
+
+void GenTxtSrcCode::codeGeneration()
+{
+    if (optind < argc)
+    {
+        try
+        {
+            // The options and variables of every file are checked as for the generation, so the paths are the same
+            if (!outputListFile.empty())
+            {
+                OutputFile list(outputListFile);
+                for (int i = optind; i < argc; ++i)
                 {
-                    if (variable.seq == "ESC")
-                    {
-                        CTextToEscSeq converter(variable, parameterInfo);
-                        headerCode.append(converter.writeDeclaration());
-                        sourceCode.append(converter.writeImplementation());
-                    }
-                    else if (variable.seq == "HEX")
-                    {
-                        CTextToHexSeq converter(variable, parameterInfo);
-                        headerCode.append(converter.writeDeclaration());
-                        sourceCode.append(converter.writeImplementation());
-                    }
-                    else if (variable.seq == "OCT")
+                    for (const std::filesystem::path &output : outputFiles(prepareFile(argv[i])))
                     {
-                        CTextToOctSeq converter(variable, parameterInfo);
-                        headerCode.append(converter.writeDeclaration());
-                        sourceCode.append(converter.writeImplementation());
-                    }
-                    else if (variable.seq == "RAWHEX")
-                    {
-                        CTextToRawHexSeq converter(variable, parameterInfo);
-                        headerCode.append(converter.writeDeclaration());
-                        sourceCode.append(converter.writeImplementation());
+                        list.stream() << output.string() << "\n";
                     }
                 }
+                list.commit();
+                return;
+            }
+
+            std::vector<std::filesystem::path> outputs;
+            std::vector<std::filesystem::path> inputs;
+            if (!cacheDirectory.empty())
+            {
+                outputCache = std::make_unique<OutputCache>(cacheDirectory, cacheSize * 1024 * 1024);
+            }
 
-                if ((parameterInfo.outputType == "cpp") && !(parameterInfo.namespaceName.empty()))
+            // Shared contents need all files, so they are prepared before the first one is generated
+            std::deque<FileJob> fileJobs;
+            if (shareFiles)
+            {
+                for (int i = optind; i < argc; ++i)
                 {
-                    const std::string nameSpaceText = "}\n";
-                    headerCode.append(nameSpaceText);
-                    sourceCode.append(nameSpaceText);
+                    fileJobs.push_back(prepareFile(argv[i]));
                 }
-                headerCode.append("#endif");
-
-                // Write to the files
-
-                const std::filesystem::path headerFilePath = parameterInfo.headerDir + "\\" + inputFileName + ".h";
-                const std::filesystem::path sourceFilePath = parameterInfo.sourceDir + "\\" + inputFileName + "." + parameterInfo.outputType;
+                shareContentsAcrossFiles(fileJobs);
+            }
 
-                std::filesystem::create_directories(headerFilePath.parent_path());
-                std::filesystem::create_directories(sourceFilePath.parent_path());
+            if (jobs <= 1)
+            {
+                for (int i = optind; i < argc; ++i)
+                {
+                    // This is where the magic happens
+                    const FileJob job = shareFiles ? fileJobs[i - optind] : prepareFile(argv[i]);
+                    const FileStatistics statistics = generateCached(job);
 
-                std::ofstream headerFile(headerFilePath.string(), std::ios::trunc);
+                    BOOST_LOG_TRIVIAL(info)
+                        << GREEN_COLOR << "Code generation successful for file: " << job.inputFileName << RESET_COLOR << std::endl;
+                    logStatistics(job.inputFileName, statistics);
 
-                if (headerFile.is_open())
+                    if (!depFile.empty())
+                    {
+                        const std::vector<std::filesystem::path> files = outputFiles(job);
+                        outputs.insert(outputs.end(), files.begin(), files.end());
+                        inputs.push_back(job.inputFilePath);
+                    }
+                }
+                if (outputCache != nullptr)
                 {
-                    headerFile << headerCode;
-                    headerFile.close();
+                    outputCache->finish();
                 }
-                else
+                if (!depFile.empty())
                 {
-                    BOOST_LOG_TRIVIAL(info)
-                        << RED_COLOR << "Could not open: " << headerFilePath.string() << RESET_COLOR << std::endl;
-                    exit(1);
+                    writeDepFile(outputs, inputs);
                 }
+                return;
+            }
 
-                std::ofstream sourceFile(sourceFilePath.string(), std::ios::trunc);
-                if (sourceFile.is_open())
+            // The options, variable names and prompts depend on the order of the files, so they are checked here one
+            // file after another. Only the generation runs on the pool, its results are logged in the order of the files.
+            // Once a file failed, no file behind it is prepared or generated any more, the ones in front of it still are.
+            ThreadPool &pool = ThreadPool::shared();
+            std::vector<std::future<FileStatistics>> results;
+            std::string prepareError;
+            std::atomic<std::size_t> firstFailed{std::numeric_limits<std::size_t>::max()};
+            for (int i = optind; i < argc && firstFailed.load() == std::numeric_limits<std::size_t>::max(); ++i)
+            {
+                const std::size_t index = results.size();
+                try
                 {
-                    sourceFile << sourceCode;
-                    sourceFile.close();
+                    if (!shareFiles)
+                    {
+                        fileJobs.push_back(prepareFile(argv[i]));
+                    }
                 }
-                else
+                catch (const std::exception &e)
                 {
-                    BOOST_LOG_TRIVIAL(info)
-                        << RED_COLOR << "Could not open: " << sourceFilePath.string() << RESET_COLOR << std::endl;
-                    exit(1);
+                    // the files already submitted still use fileJobs, so they are waited for below
+                    prepareError = e.what();
+                    break;
                 }
+                const FileJob &job = fileJobs[index];
+                results.push_back(pool.submit([this, &job, &firstFailed, index]()
+                                              {
+                                                  if (firstFailed.load() < index)
+                                                  {
+                                                      // not reported, a file in front of it failed
+                                                      return FileStatistics();
+                                                  }
+                                                  try
+                                                  {
+                                                      return generateCached(job);
+                                                  }
+                                                  catch (const std::exception &)
+                                                  {
+                                                      std::size_t failedIndex = firstFailed.load();
+                                                      while (index < failedIndex && !firstFailed.compare_exchange_weak(failedIndex, index))
+                                                      {
+                                                      }
+                                                      throw;
+                                                  } }));
+            }
 
-                BOOST_LOG_TRIVIAL(info)
-                    << GREEN_COLOR << "Code generation successful for file: " << inputFileName << RESET_COLOR << std::endl;
+            bool failed = false;
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                try
+                {
+                    const FileStatistics statistics = pool.wait(results[i]);
+                    if (!failed)
+                    {
+                        BOOST_LOG_TRIVIAL(info)
+                            << GREEN_COLOR << "Code generation successful for file: " << fileJobs[i].inputFileName << RESET_COLOR << std::endl;
+                        logStatistics(fileJobs[i].inputFileName, statistics);
+                    }
+                }
+                catch (const std::exception &e)
+                {
+                    // later files are not reported, as if they had been processed one after another
+                    if (!failed)
+                    {
+                        BOOST_LOG_TRIVIAL(error) << RED_COLOR << "Code generation failed: " << e.what() << RESET_COLOR << std::endl;
+                    }
+                    failed = true;
+                }
+            }
+            if (outputCache != nullptr)
+            {
+                outputCache->finish();
+            }
+            if (!failed && !prepareError.empty())
+            {
+                BOOST_LOG_TRIVIAL(error) << RED_COLOR << "Code generation failed: " << prepareError << RESET_COLOR << std::endl;
+                failed = true;
+            }
+            if (failed)
+            {
+                exit(1);
+            }
+            if (!depFile.empty())
+            {
+                for (const FileJob &job : fileJobs)
+                {
+                    const std::vector<std::filesystem::path> files = outputFiles(job);
+                    outputs.insert(outputs.end(), files.begin(), files.end());
+                    inputs.push_back(job.inputFilePath);
+                }
+                writeDepFile(outputs, inputs);
             }
         }
         catch (const std::exception &e)
         {
             BOOST_LOG_TRIVIAL(error) << RED_COLOR << "Code generation failed: " << e.what() << RESET_COLOR << std::endl;
+            exit(1);
         }
     }
     else
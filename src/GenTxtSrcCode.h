@@ -11,11 +11,19 @@
 
 #include <Logger.h>
 #include <map>
+#include <set>
+#include <deque>
 #include <getopt.h>
 #include <unordered_set>
+#include <vector>
+#include <memory>
+#include <filesystem>
 
 #include <ProjectPathFinder.h>
 #include <Parameter.h>
+#include <CTextToCPP.h>
+#include <ContentDeduplicator.h>
+#include <OutputCache.h>
 
 /**
  * @class GenTxtSrcCode
@@ -41,12 +49,62 @@ private:
     struct ParamStruct parameterInfo;
     struct VariableStruct variableInfo;
     bool checkArgs = true;
+    int jobs = 1; /**< Number of input files that are generated at the same time */
+    std::string cacheDirectory; /**< Directory of the output cache, empty without cache */
+    std::uintmax_t cacheSize = 1024; /**< Megabytes the output cache may take */
+    std::unique_ptr<OutputCache> outputCache; /**< The output cache, opened by codeGeneration() */
+    std::string depFile; /**< Make rule with the generated files and the input files, empty for none */
+    std::string depTarget; /**< Target of the make rule instead of the generated files, like gcc -MT */
+    std::string outputListFile; /**< Only the generated files are listed in this file, nothing is generated */
+    bool shareFiles = false; /**< Equal contents are shared across the C and C++ sources of all input files */
+
+    /**
+     * @brief A variable that points into the content of a variable of another input file.
+     */
+    struct ExternalAlias
+    {
+        std::string targetName;      /**< Name of the variable that holds the content */
+        std::string targetNamespace; /**< Namespace of its file, only for cpp */
+        std::size_t offset = 0;      /**< Position of the content in the content of the target */
+    };
+
+    /**
+     * @brief Everything needed to generate the output files of one input file.
+     */
+    struct FileJob
+    {
+        std::string inputFilePath;              /**< Path to the input file */
+        std::string inputFileName;              /**< Name of the input file without extension */
+        ParamStruct parameter;                  /**< Options valid for this file */
+        std::vector<VariableStruct> variables;  /**< Checked variables in output order */
+        std::vector<ContentAlias> aliases;      /**< Aliases found across the files, empty if findAliases() finds them */
+        std::map<std::size_t, ExternalAlias> externalAliases; /**< Variables that point into another file */
+        std::set<std::size_t> exportedContents; /**< Variables whose content other files point into */
+    };
+
+    /**
+     * @brief Sizes and buffer allocations of the output of one input file.
+     */
+    struct FileStatistics
+    {
+        std::size_t variables = 0;   /**< Number of variables */
+        std::size_t inputBytes = 0;  /**< Content bytes of all variables */
+        std::size_t headerBytes = 0; /**< Size of the header file */
+        std::size_t sourceBytes = 0; /**< Size of the source file */
+        std::size_t buffers = 0;     /**< Output buffers, the header and every variable converted into memory */
+        std::size_t allocations = 0; /**< Allocations of these buffers, equal to buffers if every size was exact */
+        std::size_t aliases = 0;     /**< Variables that point into the content of another variable */
+        std::size_t unchangedFiles = 0; /**< Output files that already had the content and were not written */
+        std::size_t cachedVariables = 0; /**< Variables copied from the previous source instead of converted */
+        bool restored = false; /**< The files were copied from the output cache instead of generated */
+        std::vector<std::filesystem::path> outputFiles; /**< Every file written for the input file */
+    };
 
     // Check if the name is a reserved keyword
     static std::unordered_set<std::string> reservedKeywords; /**< A set of reserved keywords in the C/C++ language */
 
     // Options
-    const static int optionsAmount = 10;
+    const static int optionsAmount = 22;
     const struct option longOptions[optionsAmount] = {
         {"headerdir", required_argument, nullptr, 'H'},
         {"sourcedir", required_argument, nullptr, 'S'},
@@ -54,6 +112,18 @@ private:
         {"outputfilename", required_argument, nullptr, 'f'},
         {"namespace", required_argument, nullptr, 'n'},
         {"signperline", required_argument, nullptr, 'l'},
+        {"parallelthreshold", required_argument, nullptr, 'p'},
+        {"jobs", required_argument, nullptr, 'j'},
+        {"cachedir", required_argument, nullptr, 'd'},
+        {"cachesize", required_argument, nullptr, 'm'},
+        {"depfile", required_argument, nullptr, 'D'},
+        {"deptarget", required_argument, nullptr, 'T'},
+        {"printoutputs", required_argument, nullptr, 'O'},
+        {"arraydefinitions", no_argument, nullptr, 'a'},
+        {"blob", no_argument, nullptr, 'b'},
+        {"lookup", no_argument, nullptr, 'L'},
+        {"cache", no_argument, nullptr, 'c'},
+        {"sharefiles", no_argument, nullptr, 's'},
         {"check", no_argument, nullptr, 'C'},
         {"help", no_argument, nullptr, 'h'},
         {nullptr, 0, nullptr, 0}};
@@ -67,7 +137,7 @@ private:
      * Determine the programming language from string.
      *
      * @param input The input string to check.
-     * @return The detected programming language: "cpp" for C++, "c" for C
+     * @return The detected programming language: "cpp" for C++, "c" for C, "o" for an ELF object file, "S" for an assembler file
      */
     std::string checkLanguageType(const std::string &input);
 
@@ -139,6 +209,200 @@ private:
      */
     void printExtraction(const std::map<std::string, std::string> &options, const std::vector<std::map<std::string, std::string>> &variables);
 
+    /**
+     * @brief Creates the converter for the seq of a checked variable.
+     *
+     * @param variable The checked variable.
+     * @param parameter The options of its input file.
+     * @return The converter for ESC, HEX, OCT or RAWHEX.
+     */
+    static std::unique_ptr<CTextToCPP> createConverter(const VariableStruct &variable, const ParamStruct &parameter);
+
+    /**
+     * @brief Extracts and checks the options and variables of one input file.
+     *
+     * It uses the state of the options and the used variable names left by the files before, so the files have to be
+     * prepared in the order they are given.
+     *
+     * @param userInputFileName The input file as given on the command line.
+     * @return The checked file, ready to be generated.
+     */
+    FileJob prepareFile(const std::string &userInputFileName);
+
+    /**
+     * @brief Writes the header and source file of a prepared input file.
+     *
+     * It only reads the job and no members, so several files can be generated at the same time.
+     *
+     * @param job The prepared input file.
+     * @return Sizes and buffer allocations of the written files.
+     * @throws std::runtime_error If an output file can not be opened.
+     */
+    FileStatistics generateFile(const FileJob &job);
+
+    /**
+     * @brief Returns the path of the header of a prepared input file.
+     */
+    static std::filesystem::path headerFilePath(const FileJob &job);
+
+    /**
+     * @brief Returns the path of the source, object or assembler file of a prepared input file.
+     */
+    static std::filesystem::path sourceFilePath(const FileJob &job);
+
+    /**
+     * @brief Finds the variables that point into the content of a variable of another input file.
+     *
+     * Only the string variables of C and C++ sources without array definitions or blob take part, the files of one
+     * output type are compared with each other. The aliases within a file are set as well, as a content can be found
+     * in several files. The target file exports the content, so the generated sources have to be linked together.
+     *
+     * @param fileJobs The prepared input files of the run, their aliases are set.
+     */
+    static void shareContentsAcrossFiles(std::deque<FileJob> &fileJobs);
+
+    /**
+     * @brief Finds the variables of a prepared input file that point into the content of another one.
+     *
+     * The aliases set by shareContentsAcrossFiles() are returned as they are.
+     *
+     * @param job The prepared input file.
+     * @param converters The converters of the variables of the job, used for the contents.
+     * @return One ContentAlias per variable.
+     */
+    static std::vector<ContentAlias> findAliases(const FileJob &job, const std::vector<std::shared_ptr<CTextToCPP>> &converters);
+
+    /**
+     * @brief Returns every file generateFile() writes for a prepared input file, the header first.
+     *
+     * Nothing is converted, only for assembler files the contents are compared, as the aliases get no sidecar file.
+     *
+     * @param job The prepared input file.
+     * @return The paths.
+     */
+    static std::vector<std::filesystem::path> outputFiles(const FileJob &job);
+
+    /**
+     * @brief Writes the make rule of the generated files and their input files to the depfile.
+     *
+     * The paths are written with forward slashes, the depTarget replaces the generated files if it is set.
+     *
+     * @param outputs The generated files.
+     * @param inputs The input files.
+     * @throws std::runtime_error If the depfile can not be written.
+     */
+    void writeDepFile(const std::vector<std::filesystem::path> &outputs, const std::vector<std::filesystem::path> &inputs);
+
+    /**
+     * @brief Returns the key of a prepared input file in the output cache.
+     *
+     * It hashes the version of the cached files, the bytes of the input file, the effective options and the checked
+     * variables, whose names can depend on the files before. The output directories are left out, so build trees in
+     * other places share the entries, except for assembler files, which include their sidecar files by absolute path.
+     *
+     * @param job The prepared input file.
+     * @return The key.
+     */
+    static CacheKey outputKey(const FileJob &job);
+
+    /**
+     * @brief Restores the files of a prepared input file from the output cache or generates and adds them.
+     *
+     * @param job The prepared input file.
+     * @return The statistics of generateFile(), only the restored files and their sizes for a hit.
+     * @throws std::runtime_error If an output file can not be opened.
+     */
+    FileStatistics generateCached(const FileJob &job);
+
+    /**
+     * @brief Writes the source file of a prepared input file, the declarations are added to the header parts.
+     *
+     * @param job The prepared input file.
+     * @param converters The converters of the variables of the job.
+     * @param aliases One ContentAlias per variable, a variable with another target points into its content.
+     * @param sourceFilePath Path of the source file.
+     * @param headerParts Parts of the header, the declarations are appended.
+     * @param statistics Statistics of the file, the sizes and allocations are added.
+     * @throws std::runtime_error If the source file can not be opened.
+     */
+    void writeSourceFile(const FileJob &job, const std::vector<std::shared_ptr<CTextToCPP>> &converters,
+                         const std::vector<ContentAlias> &aliases,
+                         const std::filesystem::path &sourceFilePath, std::vector<std::string> &headerParts,
+                         FileStatistics &statistics);
+
+    /**
+     * @brief Writes the variables of a prepared input file into an ELF object file, without converting them to code.
+     *
+     * @param job The prepared input file.
+     * @param converters The converters of the variables of the job, used for the declarations and the contents.
+     * @param aliases One ContentAlias per variable, a variable with another target points into its content.
+     * @param objectFilePath Path of the object file.
+     * @param headerParts Parts of the header, the extern "C" declarations are appended.
+     * @param statistics Statistics of the file, the sizes are added.
+     * @throws std::runtime_error If the object file can not be opened.
+     */
+    static void writeObjectFile(const FileJob &job, const std::vector<std::shared_ptr<CTextToCPP>> &converters,
+                                const std::vector<ContentAlias> &aliases,
+                                const std::filesystem::path &objectFilePath, std::vector<std::string> &headerParts,
+                                FileStatistics &statistics);
+
+    /**
+     * @brief Writes a GNU assembler file that includes the contents of the variables from binary sidecar files.
+     *
+     * @param job The prepared input file.
+     * @param converters The converters of the variables of the job, used for the declarations and the contents.
+     * @param aliases One ContentAlias per variable, a variable with another target points into its content.
+     * @param assemblerFilePath Path of the assembler file, the sidecar files are written next to it.
+     * @param headerParts Parts of the header, the extern "C" declarations and the size symbols are appended.
+     * @param statistics Statistics of the file, the sizes are added.
+     * @throws std::runtime_error If the assembler file or a sidecar file can not be opened.
+     */
+    static void writeIncbinFile(const FileJob &job, const std::vector<std::shared_ptr<CTextToCPP>> &converters,
+                                const std::vector<ContentAlias> &aliases,
+                                const std::filesystem::path &assemblerFilePath, std::vector<std::string> &headerParts,
+                                FileStatistics &statistics);
+
+    /**
+     * @brief Packs the contents of all variables of a prepared input file into one char array, the blob.
+     *
+     * Every content is followed by its NUL, an alias points into the content of its target. The header gets a table
+     * with offset and size of every variable, an inline accessor NAME() and a NAME_size constant per variable, so only
+     * the blob is a symbol. It is written as source, as ELF object file or as assembler file, as the output type says.
+     *
+     * @param job The prepared input file.
+     * @param converters The converters of the variables of the job, used for the accessors and the contents.
+     * @param aliases One ContentAlias per variable, a variable with another target points into its content.
+     * @param sourceFilePath Path of the source, object or assembler file, a sidecar file is written next to it.
+     * @param headerParts Parts of the header, the table and the accessors are appended.
+     * @param statistics Statistics of the file, the sizes are added.
+     * @throws std::runtime_error If an output file can not be opened.
+     */
+    static void writeBlobFile(const FileJob &job, const std::vector<std::shared_ptr<CTextToCPP>> &converters,
+                              const std::vector<ContentAlias> &aliases,
+                              const std::filesystem::path &sourceFilePath, std::vector<std::string> &headerParts,
+                              FileStatistics &statistics);
+
+    /**
+     * @brief Returns the lookup of the variables of a prepared input file by name, for the header.
+     *
+     * The perfect hash over the names is built here, the header gets its tables, the names and the function
+     * NAME_lookup(name, length), with a std::string_view overload for C++17. A lookup hashes the name twice and
+     * compares it with the one name in its slot, nothing is allocated or initialized at startup.
+     *
+     * @param job The prepared input file.
+     * @param converters The converters of the variables of the job, used for the sizes.
+     * @return The header code.
+     */
+    static std::string writeLookup(const FileJob &job, const std::vector<std::shared_ptr<CTextToCPP>> &converters);
+
+    /**
+     * @brief Logs the statistics of a generated file.
+     *
+     * @param inputFileName Name of the input file.
+     * @param statistics Statistics returned by generateFile().
+     */
+    static void logStatistics(const std::string &inputFileName, const FileStatistics &statistics);
+
     /**
      * @brief Generates the code based on the parsed command-line options and input files.
      */
@@ -0,0 +1,60 @@
+#define BOOST_TEST_MODULE AsciiValidatortests
+#include <boost/test/unit_test.hpp>
+#include <AsciiValidator.h>
+
+BOOST_AUTO_TEST_SUITE(AsciiValidatorTestSuite)
+
+BOOST_AUTO_TEST_CASE(findNonAsciiTest)
+{
+    //Setup: a non ASCII character at every position of the SIMD blocks and the scalar tail
+    const std::size_t length = 300;
+    for (std::size_t pos = 0; pos < length; ++pos)
+    {
+        std::string input(length, 'a');
+        input[pos] = static_cast<char>(0xC3);
+
+        //Testing
+        BOOST_CHECK_EQUAL(findNonAscii(input.data(), input.size()), pos);
+    }
+
+    const std::string ascii(length, '\x7F');
+    BOOST_CHECK_EQUAL(findNonAscii(ascii.data(), ascii.size()), length);
+    BOOST_CHECK_EQUAL(findNonAscii(ascii.data(), 0), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(validateAsciiTest)
+{
+    //Given Input: three errors in two lines, the last one behind the first chunk
+    std::string input = "ab\xE4" "c\n\xF6\n";
+    input.append(SOURCE_CHUNK_SIZE, 'x');
+    input += "\n  \xFC";
+    StringSource source(input);
+
+    //Testing
+    const std::vector<AsciiError> errors = validateAscii(source, 10);
+    BOOST_REQUIRE_EQUAL(errors.size(), 3u);
+    BOOST_CHECK_EQUAL(errors[0].line, 10);
+    BOOST_CHECK_EQUAL(errors[0].column, 3u);
+    BOOST_CHECK_EQUAL(errors[1].line, 11);
+    BOOST_CHECK_EQUAL(errors[1].column, 1u);
+    BOOST_CHECK_EQUAL(errors[2].line, 13);
+    BOOST_CHECK_EQUAL(errors[2].column, 3u);
+    BOOST_CHECK_EQUAL(errors[2].value, 0xFC);
+
+    // the source is rewound for the conversion
+    char first;
+    BOOST_CHECK_EQUAL(source.read(&first, 1), 1u);
+    BOOST_CHECK_EQUAL(first, 'a');
+}
+
+BOOST_AUTO_TEST_CASE(validAsciiTest)
+{
+    //Setup
+    const std::string input = "Only\tASCII\r\nText\n";
+    StringSource source(input);
+
+    //Testing
+    BOOST_CHECK(validateAscii(source, 1).empty());
+    BOOST_CHECK_EQUAL(describeAsciiError({4, 7, 0xE4}, "input.txt"), "ASCII ERROR in: input.txt in line: 4 column: 7 (0xE4)");
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,79 @@
+#define BOOST_TEST_MODULE ByteSourcetests
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <ByteSource.h>
+
+namespace
+{
+    void writeFile(const std::string &path, const std::string &content)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+
+    std::string readAll(ByteSource &source)
+    {
+        std::string content;
+        std::vector<char> buffer(SOURCE_CHUNK_SIZE);
+        std::size_t count;
+        while ((count = source.read(buffer.data(), buffer.size())) > 0)
+        {
+            content.append(buffer.data(), count);
+        }
+        return content;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(ByteSourceTestSuite)
+
+BOOST_AUTO_TEST_CASE(fileRangeTest)
+{
+    //Setup: the range is created before its file
+    const std::string path = "TESTByteSource_range.txt";
+    std::remove(path.c_str());
+    FileRangeSource range(path, 2, 3);
+    writeFile(path, "abcdefg");
+
+    //Testing: the file is opened by the first read
+    BOOST_CHECK_EQUAL(range.size(), 3u);
+    BOOST_CHECK_EQUAL(readAll(range), "cde");
+
+    //Testing: it is closed at the end of the range, so a rewound range reads the file again
+    std::remove(path.c_str());
+    writeFile(path, "ABCDEFG");
+    range.rewind();
+    BOOST_CHECK_EQUAL(readAll(range), "CDE");
+
+    std::remove(path.c_str());
+    range.rewind();
+    char byte;
+    BOOST_CHECK_THROW(range.read(&byte, 1), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(concatSourceTest)
+{
+    //Setup: a blob of more file ranges than a process may have open files, every one followed by its NUL
+    const std::string path = "TESTByteSource_concat.txt";
+    const std::size_t count = 5000;
+    static const std::string terminator(1, '\0');
+    writeFile(path, "0123456789");
+    std::vector<std::unique_ptr<ByteSource>> parts;
+    std::string expected;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        parts.push_back(std::make_unique<FileRangeSource>(path, static_cast<std::streamoff>(i % 8), 2));
+        parts.push_back(std::make_unique<StringSource>(terminator));
+        expected += std::string("0123456789").substr(i % 8, 2) + terminator;
+    }
+
+    //Testing
+    ConcatSource blob(std::move(parts));
+    BOOST_CHECK_EQUAL(blob.size(), expected.size());
+    BOOST_CHECK(readAll(blob) == expected);
+    blob.rewind();
+    BOOST_CHECK(readAll(blob) == expected);
+    std::remove(path.c_str());
+}
+BOOST_AUTO_TEST_SUITE_END()
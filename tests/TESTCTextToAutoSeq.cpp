@@ -0,0 +1,54 @@
+#define BOOST_TEST_MODULE CTextToAutoSeqtests
+#include <boost/test/unit_test.hpp>
+#include <Parameter.h>
+#define private public
+#include <CTextToAutoSeq.h>
+
+BOOST_AUTO_TEST_SUITE(CTextToAutoSeqTestSuite)
+
+BOOST_AUTO_TEST_CASE(convertTest)
+{
+    //Setup
+    VariableStruct variableStruct;
+    variableStruct.nl = "UNIX";
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 200;
+    //Given Input: named escapes, quotes, control characters in front of digits and trigraph characters
+    variableStruct.content = std::string("It's \"x\"\t\\ \a\x1b") + '\0' + "A" + '\0' + "7\x1f" + "8\x1f" + "1\x7f?\?=?";
+
+    //Expected Output
+    const std::string expected = "\"It's \\\"x\\\"\\t\\\\ \\a\\33\\0A\\0007\\378\\0371\\177?\\?=?\" \\\n";
+
+    //Testing
+    CTextToAutoSeq converter(variableStruct,paramStruct);
+    std::string result;
+    StringSink sink(result);
+    converter.writeContent(sink);
+    BOOST_CHECK_EQUAL(result, expected);
+}
+
+BOOST_AUTO_TEST_CASE(writeImplementationTest)
+{
+    //Setup: the octal escape sequence in front of the end of a chunk still sees the digit behind it
+    VariableStruct variableStruct;
+    variableStruct.name = "TEXT";
+    variableStruct.seq = "AUTO";
+    variableStruct.nl = "UNIX";
+    variableStruct.content = std::string(SOURCE_CHUNK_SIZE - 1, 'a') + '\x01' + "2 what??\nend\n";
+    variableStruct.VariableLineNumber = 1;
+    variableStruct.addtextsegment = false;
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 2 * SOURCE_CHUNK_SIZE;
+
+    //Expected Output: words and new lines are wrapped like ESC
+    const std::string expected = "const char *const TEXT = {\n"
+                                 "\"" + std::string(SOURCE_CHUNK_SIZE - 1, 'a') + "\\0012 what?\\?\\n\" \\\n"
+                                 "\"end\" \\\n"
+                                 "};\n";
+
+    //Testing
+    CTextToAutoSeq converter(variableStruct,paramStruct);
+    BOOST_CHECK_EQUAL(converter.writeImplementation(), expected);
+    BOOST_CHECK_EQUAL(converter.implementationSize(), expected.size());
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,10 @@
 #define BOOST_TEST_MODULE CTextToEscSeqtests
 #include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <cstdio>
+#include <stdexcept>
 #include <Parameter.h>
+#include <ThreadPool.h>
 #define private public
 #include <CTextToEscSeq.h>
 
@@ -10,18 +14,302 @@ BOOST_AUTO_TEST_CASE(convertTest)
 {
     //Setup
     VariableStruct variableStruct;
+    variableStruct.nl = "UNIX";
     ParamStruct paramStruct;
+    paramStruct.signPerLine = 200;
     //Given Input
-    //"Wortdavor\a\b\e\f\n\r\t\v\\\'\"\?Wortdahinter"
-    std::string input = "a";
+    variableStruct.content = "a\n";
+
+    //Expected Output: the trailing new line is removed
+    const std::string expected = "\"a\" \\\n";
+
+    //Testing
+    CTextToEscSeq converter(variableStruct,paramStruct);
+    std::string result;
+    StringSink sink(result);
+    converter.writeContent(sink);
+    BOOST_CHECK_EQUAL(result, expected);
+}
+
+BOOST_AUTO_TEST_CASE(convertAllEscapesTest)
+{
+    //Setup
+    VariableStruct variableStruct;
+    variableStruct.nl = "UNIX";
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 200;
+    //Given Input
+    variableStruct.content = "Wortdavor\a\b\e\f\n\r\t\v\\\'\"\?Wortdahinter";
+
+    //Expected Output: the line ends behind the new line
+    const std::string expected = "\"Wortdavor\\a\\b\\e\\f\\n\" \\\n"
+                                 "\"\\r\\t\\v\\\\\\'\\\"\\?Wortdahinter\" \\\n";
+
+    //Testing
+    CTextToEscSeq converter(variableStruct,paramStruct);
+    std::string result;
+    StringSink sink(result);
+    converter.writeContent(sink);
+    BOOST_CHECK_EQUAL(result, expected);
+}
+
+BOOST_AUTO_TEST_CASE(convertLongInputTest)
+{
+    //Setup
+    VariableStruct variableStruct;
+    variableStruct.nl = "UNIX";
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 200;
+    //Given Input
+    //Escapes at the borders of the 16 and 32 byte blocks and in the scalar tail
+    std::string input(100, 'x');
+    for (const int pos : {0, 15, 16, 31, 32, 33, 63, 64, 95, 98})
+    {
+        input[pos] = '"';
+    }
+    input[47] = '\t';
+    variableStruct.content = input;
 
     //Expected Output
-    //"Wortdavor\\a\\b\\e\\f\\n\\r\\t\\v\\\\\\'\\\"\\?Wortdahinter"
-    const std::string expected = "a";
+    std::string expected = "\"";
+    for (const char c : input)
+    {
+        if (c == '"')
+            expected += "\\\"";
+        else if (c == '\t')
+            expected += "\\t";
+        else
+            expected += c;
+    }
+    expected += "\" \\\n";
 
     //Testing
     CTextToEscSeq converter(variableStruct,paramStruct);
-    std::string result = converter.convert(input,60,"test.txt","\n");
-    BOOST_CHECK(expected == result);
+    std::string result;
+    StringSink sink(result);
+    converter.writeContent(sink);
+    BOOST_CHECK_EQUAL(result, expected);
+}
+
+BOOST_AUTO_TEST_CASE(writeImplementationTest)
+{
+    //Setup
+    VariableStruct variableStruct;
+    variableStruct.name = "TEXT";
+    variableStruct.seq = "ESC";
+    variableStruct.nl = "UNIX";
+    variableStruct.content = "Hello World\n\"Second\" line \\n\n";
+    variableStruct.VariableLineNumber = 1;
+    variableStruct.addtextsegment = false;
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 12;
+
+    //Expected Output: words are not split, nothing is added to the text and the escaped backslash is no new line
+    const std::string expected = "const char *const TEXT = {\n"
+                                 "\"Hello World\" \\\n"
+                                 "\"\\n\" \\\n"
+                                 "\"\\\"Second\\\" \" \\\n"
+                                 "\"line \\\\n\" \\\n"
+                                 "};\n";
+
+    //Testing
+    CTextToEscSeq converter(variableStruct,paramStruct);
+    BOOST_CHECK_EQUAL(converter.writeImplementation(), expected);
+}
+BOOST_AUTO_TEST_CASE(arrayDefinitionsTest)
+{
+    //Setup
+    VariableStruct variableStruct;
+    variableStruct.name = "TEXT";
+    variableStruct.seq = "ESC";
+    variableStruct.nl = "UNIX";
+    variableStruct.content = "Hello World\n\"Second\"\n";
+    variableStruct.VariableLineNumber = 1;
+    variableStruct.addtextsegment = false;
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 12;
+    paramStruct.arrayDefinitions = true;
+
+    //Expected Output: the same literals initialize an array, its length is a constant of the declaration
+    const std::string expected = "const char TEXT[] = {\n"
+                                 "\"Hello World\" \\\n"
+                                 "\"\\n\" \\\n"
+                                 "\"\\\"Second\\\"\" \\\n"
+                                 "};\n";
+
+    //Testing
+    CTextToEscSeq converter(variableStruct,paramStruct);
+    BOOST_CHECK_EQUAL(converter.writeImplementation(), expected);
+    BOOST_CHECK_EQUAL(converter.writeDeclaration(true), "extern const char TEXT[];\n"
+                                                        "static const size_t TEXT_size = 20;\n");
+
+    // an empty content still defines the NUL
+    variableStruct.content = "\n";
+    CTextToEscSeq empty(variableStruct,paramStruct);
+    BOOST_CHECK_EQUAL(empty.writeImplementation(), "const char TEXT[] = {\n\"\"\n};\n");
+    BOOST_CHECK_EQUAL(empty.implementationSize(), empty.writeImplementation().size());
+}
+BOOST_AUTO_TEST_CASE(sharedContentTest)
+{
+    //Setup
+    VariableStruct variableStruct;
+    variableStruct.name = "TEXT";
+    variableStruct.seq = "ESC";
+    variableStruct.nl = "UNIX";
+    variableStruct.content = "Hello\n";
+    variableStruct.VariableLineNumber = 1;
+    variableStruct.addtextsegment = false;
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 12;
+    paramStruct.outputType = "cpp";
+
+    //Expected Output: a shared content stays in the source file, an exported one is extern for the other C++ sources
+    const std::string content = "_content[] = {\n\"Hello\" \\\n};\nconst char *const TEXT = TEXT_content;\n";
+
+    //Testing
+    CTextToEscSeq shared(variableStruct,paramStruct);
+    shared.shareContent();
+    BOOST_CHECK_EQUAL(shared.writeImplementation(), "static const char TEXT" + content);
+    CTextToEscSeq exported(variableStruct,paramStruct);
+    exported.exportContent();
+    BOOST_CHECK_EQUAL(exported.writeImplementation(), "extern const char TEXT" + content);
+    BOOST_CHECK(exported.implementationKey() != shared.implementationKey());
+    BOOST_CHECK_EQUAL(exported.writeAliasDefinition("::ns::TEXT", 2), "const char *const TEXT = ::ns::TEXT_content + 2;\n");
+
+    // in C a const array at file scope already has external linkage
+    paramStruct.outputType = "c";
+    CTextToEscSeq exportedC(variableStruct,paramStruct);
+    exportedC.exportContent();
+    BOOST_CHECK_EQUAL(exportedC.writeImplementation(), "const char TEXT" + content);
+}
+BOOST_AUTO_TEST_CASE(blobAccessorTest)
+{
+    //Setup
+    VariableStruct variableStruct;
+    variableStruct.name = "TEXT";
+    variableStruct.seq = "ESC";
+    variableStruct.nl = "UNIX";
+    variableStruct.content = "Hello World\n";
+    variableStruct.doxygen = "Greeting";
+    variableStruct.VariableLineNumber = 1;
+    variableStruct.addtextpos = false;
+    variableStruct.addtextsegment = false;
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 60;
+    paramStruct.packedBlob = true;
+
+    //Testing: the literals alone go into the blob, the header gets the accessor and the size
+    CTextToEscSeq converter(variableStruct,paramStruct);
+    std::string content;
+    StringSink sink(content);
+    converter.writeContent(sink);
+    BOOST_CHECK_EQUAL(content, "\"Hello World\" \\\n");
+    BOOST_CHECK_EQUAL(converter.writeBlobAccessor("FILE_blob", 12), "/** Greeting*/\n"
+                                                                    "static inline const char *TEXT(void) { return FILE_blob + 12; }\n"
+                                                                    "static const size_t TEXT_size = 11;\n");
+}
+BOOST_AUTO_TEST_CASE(implementationSizeTest)
+{
+    //Setup: breaks of every mode, words longer than a line and the original text behind the code
+    const std::string content = "Hello World\r\n\"Second\" line \\n\rand averyveryverylongword\tfor the line\n\r\n";
+
+    for (const std::string nl : {"UNIX", "DOS", "MAC"})
+    {
+        for (const int signPerLine : {0, 5, 12, 60})
+        {
+            VariableStruct variableStruct;
+            variableStruct.name = "TEXT";
+            variableStruct.seq = "ESC";
+            variableStruct.nl = nl;
+            variableStruct.content = content;
+            variableStruct.VariableLineNumber = 1;
+            variableStruct.addtextsegment = true;
+            ParamStruct paramStruct;
+            paramStruct.signPerLine = signPerLine;
+
+            //Testing: the counted size is exact, so the text is written with one allocation
+            CTextToEscSeq converter(variableStruct,paramStruct);
+            std::string output;
+            StringSink sink(output, converter.implementationSize());
+            converter.writeImplementation(sink);
+            BOOST_CHECK_EQUAL(output.size(), converter.implementationSize());
+            BOOST_CHECK_EQUAL(sink.allocations(), 1u);
+        }
+    }
+}
+BOOST_AUTO_TEST_CASE(streamedContentTest)
+{
+    //Setup: the same content once in memory and once as range of a file, longer than one chunk
+    std::string content;
+    for (int i = 0; content.size() < 3 * SOURCE_CHUNK_SIZE; ++i)
+    {
+        content += "Line " + std::to_string(i) + " with \"quotes\" and\ttabs\n";
+    }
+    const std::string fileName = "TESTCTextToEscSeqInput.txt";
+    {
+        std::ofstream file(fileName, std::ios::trunc);
+        file << "@variable\n" << content << "@endvariable\n";
+    }
+
+    VariableStruct variableStruct;
+    variableStruct.name = "TEXT";
+    variableStruct.seq = "ESC";
+    variableStruct.nl = "UNIX";
+    variableStruct.content = content;
+    variableStruct.VariableLineNumber = 1;
+    variableStruct.addtextsegment = true;
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 60;
+
+    VariableStruct streamedStruct = variableStruct;
+    streamedStruct.content.clear();
+    streamedStruct.sourceFile = fileName;
+    streamedStruct.contentOffset = 10;
+    streamedStruct.contentLength = content.size();
+    streamedStruct.contentTail = "n\n";
+
+    //Testing
+    CTextToEscSeq inMemory(variableStruct,paramStruct);
+    CTextToEscSeq streamed(streamedStruct,paramStruct);
+    const std::string expected = inMemory.writeImplementation();
+    BOOST_CHECK(streamed.writeImplementation() == expected);
+
+    std::remove(fileName.c_str());
+
+    //Testing: a removed input file is an error of this file only, the program goes on
+    BOOST_CHECK_THROW(streamed.writeImplementation(), std::runtime_error);
+}
+BOOST_AUTO_TEST_CASE(parallelContentTest)
+{
+    //Setup: several blocks of lines, followed by one long line without a break the blocks can end at
+    ThreadPool::setSharedSize(4);
+    std::string content;
+    for (int i = 0; content.size() < 80 * SOURCE_CHUNK_SIZE; ++i)
+    {
+        content += "Line " + std::to_string(i) + " with\r\n breaks \\n and\ttabs\n";
+    }
+    content.append(40 * SOURCE_CHUNK_SIZE, 'x');
+    content += "\n";
+
+    for (const std::string nl : {"UNIX", "DOS", "MAC"})
+    {
+        VariableStruct variableStruct;
+        variableStruct.name = "TEXT";
+        variableStruct.seq = "ESC";
+        variableStruct.nl = nl;
+        variableStruct.content = content;
+        variableStruct.VariableLineNumber = 1;
+        variableStruct.addtextsegment = false;
+        ParamStruct paramStruct;
+        paramStruct.signPerLine = 60;
+
+        ParamStruct parallelStruct = paramStruct;
+        parallelStruct.parallelThreshold = 1;
+
+        //Testing
+        CTextToEscSeq serial(variableStruct,paramStruct);
+        CTextToEscSeq parallel(variableStruct,parallelStruct);
+        BOOST_CHECK(parallel.writeImplementation() == serial.writeImplementation());
+    }
 }
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,194 @@
+#define BOOST_TEST_MODULE CTextToRawHexSeqtests
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <memory>
+#include <Parameter.h>
+#include <CTextToRawHexSeq.h>
+#include <CTextToHexSeq.h>
+#include <CTextToOctSeq.h>
+
+BOOST_AUTO_TEST_SUITE(CTextToRawHexSeqTestSuite)
+
+BOOST_AUTO_TEST_CASE(writeImplementationTest)
+{
+    //Setup
+    VariableStruct variableStruct;
+    variableStruct.name = "RAW";
+    variableStruct.seq = "RAWHEX";
+    variableStruct.nl = "UNIX";
+    variableStruct.content = "ABC\n";
+    variableStruct.VariableLineNumber = 1;
+    variableStruct.addtextsegment = false;
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 10;
+
+    //Expected Output: the last element has no comma
+    const std::string expected = "const char RAW[] = {\n"
+                                 "0x41,0x42, \\\n"
+                                 "0x43 \\\n"
+                                 "};\n";
+
+    //Testing
+    CTextToRawHexSeq converter(variableStruct,paramStruct);
+    BOOST_CHECK_EQUAL(converter.writeImplementation(), expected);
+    BOOST_CHECK_EQUAL(converter.writeDeclaration(), "const char RAW[];\n");
+}
+
+BOOST_AUTO_TEST_CASE(embedTest)
+{
+    //Setup
+    VariableStruct variableStruct;
+    variableStruct.name = "EMBEDDED";
+    variableStruct.seq = "EMBED";
+    variableStruct.nl = "UNIX";
+    variableStruct.content = "ABC\n";
+    variableStruct.VariableLineNumber = 1;
+    variableStruct.addtextsegment = false;
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 10;
+    paramStruct.inputFileName = "text";
+
+    //Expected Output: #embed of the binary file named after the input file, the RAWHEX elements without support for it
+    const std::string expected = "const unsigned char EMBEDDED[] = {\n"
+                                 "#if defined(__has_embed)\n"
+                                 "#embed \"text_EMBEDDED.bin\" if_empty(0)\n"
+                                 "#else\n"
+                                 "0x41,0x42, \\\n"
+                                 "0x43 \\\n"
+                                 "\n"
+                                 "#endif\n"
+                                 "};\n";
+
+    //Testing
+    CTextToRawHexSeq converter(variableStruct,paramStruct);
+    const std::string output = converter.writeImplementation();
+    BOOST_CHECK_EQUAL(output, expected);
+    BOOST_CHECK_EQUAL(converter.implementationSize(), expected.size());
+    BOOST_CHECK_EQUAL(converter.writeDeclaration(true), "extern const unsigned char EMBEDDED[];\n");
+
+    // the binary file holds the content without its trailing new line
+    BOOST_CHECK_EQUAL(converter.embedFilePath(), "text_EMBEDDED.bin");
+    std::ifstream file(converter.embedFilePath(), std::ios::binary);
+    std::stringstream binary;
+    binary << file.rdbuf();
+    BOOST_CHECK_EQUAL(binary.str(), "ABC");
+    file.close();
+    std::remove(converter.embedFilePath().c_str());
+}
+BOOST_AUTO_TEST_CASE(packedWordsTest)
+{
+    //Setup
+    VariableStruct variableStruct;
+    variableStruct.name = "PACKED";
+    variableStruct.seq = "RAWHEX64";
+    variableStruct.nl = "UNIX";
+    variableStruct.content = "ABCDEFGHIJ\n";
+    variableStruct.VariableLineNumber = 1;
+    variableStruct.addtextsegment = false;
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 60;
+
+    //Expected Output: little endian words, the last one padded with zeros
+    const std::string expected = "const uint64_t PACKED[] = {\n"
+                                 "0x4847464544434241,0x0000000000004a49 \\\n"
+                                 "};\n";
+
+    //Testing
+    CTextToRawHexSeq converter(variableStruct,paramStruct);
+    BOOST_CHECK_EQUAL(converter.writeImplementation(), expected);
+    BOOST_CHECK_EQUAL(converter.implementationSize(), expected.size());
+    BOOST_CHECK_EQUAL(converter.writeDeclaration(), "const uint64_t PACKED[];\n"
+                                                    "static const size_t PACKED_size = 10;\n");
+
+    // a content that fills the last word needs no padding
+    variableStruct.seq = "RAWHEX32";
+    variableStruct.content = "ABCDEFGH\n";
+    CTextToRawHexSeq words(variableStruct,paramStruct);
+    BOOST_CHECK_EQUAL(words.writeImplementation(), "const uint32_t PACKED[] = {\n"
+                                                   "0x44434241,0x48474645 \\\n"
+                                                   "};\n");
+}
+BOOST_AUTO_TEST_CASE(emptyContentTest)
+{
+    //Setup
+    VariableStruct variableStruct;
+    variableStruct.name = "EMPTY";
+    variableStruct.nl = "UNIX";
+    variableStruct.content = "\n";
+    variableStruct.VariableLineNumber = 1;
+    variableStruct.addtextsegment = false;
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 60;
+    paramStruct.inputFileName = "text";
+
+    //Testing: an array without elements is no valid C, so it gets a single 0 and its size stays 0
+    variableStruct.seq = "RAWHEX";
+    CTextToRawHexSeq bytes(variableStruct,paramStruct);
+    BOOST_CHECK_EQUAL(bytes.writeImplementation(), "const char EMPTY[] = {\n0\n};\n");
+    BOOST_CHECK_EQUAL(bytes.implementationSize(), bytes.writeImplementation().size());
+
+    variableStruct.seq = "RAWHEX32";
+    CTextToRawHexSeq words(variableStruct,paramStruct);
+    BOOST_CHECK_EQUAL(words.writeImplementation(), "const uint32_t EMPTY[] = {\n0\n};\n");
+    BOOST_CHECK_EQUAL(words.implementationSize(), words.writeImplementation().size());
+    BOOST_CHECK_EQUAL(words.writeDeclaration(), "const uint32_t EMPTY[];\n"
+                                                "static const size_t EMPTY_size = 0;\n");
+
+    //Testing: #embed of the empty file gives the same element as the fallback
+    variableStruct.seq = "EMBED";
+    CTextToRawHexSeq embedded(variableStruct,paramStruct);
+    const std::string expected = "const unsigned char EMPTY[] = {\n"
+                                 "#if defined(__has_embed)\n"
+                                 "#embed \"text_EMPTY.bin\" if_empty(0)\n"
+                                 "#else\n"
+                                 "0\n"
+                                 "\n"
+                                 "#endif\n"
+                                 "};\n";
+    BOOST_CHECK_EQUAL(embedded.writeImplementation(), expected);
+    BOOST_CHECK_EQUAL(embedded.implementationSize(), expected.size());
+    std::remove(embedded.embedFilePath().c_str());
+}
+BOOST_AUTO_TEST_CASE(fixedWidthSizeTest)
+{
+    //Setup: breaks of every mode, runs of CRs and lines that are shorter than one fragment
+    const std::string content = "Hello World\r\n\"Second\" line\rand\r\r\r a longer line for the wrapping\n\r\nx\n";
+
+    for (const std::string seq : {"HEX", "OCT", "RAWHEX", "RAWHEX32", "RAWHEX64"})
+    {
+        for (const std::string nl : {"UNIX", "DOS", "MAC"})
+        {
+            for (const int signPerLine : {0, 5, 12, 19, 60})
+            {
+                VariableStruct variableStruct;
+                variableStruct.name = "TEXT";
+                variableStruct.seq = seq;
+                variableStruct.nl = nl;
+                variableStruct.content = content;
+                variableStruct.VariableLineNumber = 1;
+                variableStruct.addtextsegment = true;
+                ParamStruct paramStruct;
+                paramStruct.signPerLine = signPerLine;
+
+                //Testing: the size follows from the fragment widths and the new lines alone
+                std::unique_ptr<CTextToCPP> converter;
+                if (seq == "HEX")
+                {
+                    converter = std::make_unique<CTextToHexSeq>(variableStruct, paramStruct);
+                }
+                else if (seq == "OCT")
+                {
+                    converter = std::make_unique<CTextToOctSeq>(variableStruct, paramStruct);
+                }
+                else
+                {
+                    converter = std::make_unique<CTextToRawHexSeq>(variableStruct, paramStruct);
+                }
+                BOOST_CHECK_EQUAL(converter->implementationSize(), converter->writeImplementation().size());
+            }
+        }
+    }
+}
+BOOST_AUTO_TEST_SUITE_END()
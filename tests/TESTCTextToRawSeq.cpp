@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE CTextToRawSeqtests
+#include <boost/test/unit_test.hpp>
+#include <Parameter.h>
+#include <CTextToRawSeq.h>
+#include <ThreadPool.h>
+
+BOOST_AUTO_TEST_SUITE(CTextToRawSeqTestSuite)
+
+BOOST_AUTO_TEST_CASE(findDelimiterTest)
+{
+    //Setup: the content closes raw strings without delimiter and with "a", a longer one is split into chunks
+    const std::string content = "f(x)\" and )a\" but not )b or )c)" + std::string(SOURCE_CHUNK_SIZE, ' ') + ")b\"";
+
+    //Testing
+    StringSource source(content);
+    BOOST_CHECK_EQUAL(CTextToRawSeq::findDelimiter(source), "c");
+
+    StringSource plain("no parenthesis");
+    BOOST_CHECK_EQUAL(CTextToRawSeq::findDelimiter(plain), "");
+}
+
+BOOST_AUTO_TEST_CASE(writeImplementationTest)
+{
+    //Setup
+    VariableStruct variableStruct;
+    variableStruct.name = "TEXT";
+    variableStruct.seq = "RAW";
+    variableStruct.nl = "DOS";
+    variableStruct.content = "Say \"Hi\" (or \\n)\"\r\n\tsecond\r\n";
+    variableStruct.VariableLineNumber = 1;
+    variableStruct.addtextsegment = false;
+    ParamStruct paramStruct;
+    paramStruct.signPerLine = 10;
+
+    //Expected Output: the content as it is, the carriage return in an ordinary literal
+    const std::string expected = "const char *const TEXT = {\n"
+                                 "R\"a(Say \"Hi\" (or \\n)\")a\"\n"
+                                 "\"\\r\"\n"
+                                 "R\"a(\n"
+                                 "\tsecond)a\"\n"
+                                 "};\n";
+
+    //Testing
+    CTextToRawSeq converter(variableStruct,paramStruct);
+    BOOST_CHECK_EQUAL(converter.writeImplementation(), expected);
+    BOOST_CHECK_EQUAL(converter.implementationSize(), expected.size());
+}
+
+BOOST_AUTO_TEST_CASE(pieceSizeTest)
+{
+    //Setup: a content longer than one literal may be
+    VariableStruct variableStruct;
+    variableStruct.name = "LONG";
+    variableStruct.seq = "RAW";
+    variableStruct.nl = "UNIX";
+    variableStruct.content = std::string(RAW_PIECE_SIZE + 5, 'x') + "\n";
+    variableStruct.VariableLineNumber = 1;
+    variableStruct.addtextsegment = false;
+    ParamStruct paramStruct;
+
+    //Expected Output: two adjacent literals
+    const std::string expected = "const char *const LONG = {\n"
+                                 "R\"(" + std::string(RAW_PIECE_SIZE, 'x') + ")\"\n"
+                                 "R\"(xxxxx)\"\n"
+                                 "};\n";
+
+    //Testing
+    CTextToRawSeq converter(variableStruct,paramStruct);
+    BOOST_CHECK_EQUAL(converter.writeImplementation(), expected);
+}
+
+BOOST_AUTO_TEST_CASE(parallelContentTest)
+{
+    //Setup: a content far above the threshold, with a parenthesis that needs a delimiter and lines longer than a literal
+    ThreadPool::setSharedSize(4);
+    std::string content;
+    for (int i = 0; content.size() < 80 * SOURCE_CHUNK_SIZE; ++i)
+    {
+        content += "Line " + std::to_string(i) + " ends )\" here\n";
+    }
+    content.append(RAW_PIECE_SIZE + 5, 'x');
+
+    for (const std::string nl : {"UNIX", "DOS"})
+    {
+        VariableStruct variableStruct;
+        variableStruct.name = "TEXT";
+        variableStruct.seq = "RAW";
+        variableStruct.nl = nl;
+        variableStruct.content = content;
+        variableStruct.VariableLineNumber = 1;
+        variableStruct.addtextsegment = false;
+        ParamStruct paramStruct;
+
+        ParamStruct parallelStruct = paramStruct;
+        parallelStruct.parallelThreshold = 1;
+
+        //Testing: the same single delimiter and the same literals as the serial conversion
+        CTextToRawSeq serial(variableStruct,paramStruct);
+        CTextToRawSeq parallel(variableStruct,parallelStruct);
+        BOOST_CHECK(parallel.writeImplementation() == serial.writeImplementation());
+    }
+}
+BOOST_AUTO_TEST_SUITE_END()
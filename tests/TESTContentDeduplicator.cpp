@@ -0,0 +1,124 @@
+#define BOOST_TEST_MODULE ContentDeduplicatortests
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <ContentDeduplicator.h>
+
+BOOST_AUTO_TEST_SUITE(ContentDeduplicatorTestSuite)
+
+BOOST_AUTO_TEST_CASE(endsWithTest)
+{
+    //Setup: the suffix starts in the first chunk of the content and ends in the second one
+    const std::string content = std::string(SOURCE_CHUNK_SIZE - 3, 'a') + "tail end";
+    const std::string suffixText = "tail end";
+    const std::string otherText = "tail fnd";
+    const std::string tooLongText = "x" + content;
+
+    //Testing
+    StringSource longer(content);
+    StringSource suffix(suffixText);
+    BOOST_CHECK(endsWith(longer, suffix));
+
+    StringSource other(otherText);
+    BOOST_CHECK(!endsWith(longer, other));
+
+    StringSource tooLong(tooLongText);
+    BOOST_CHECK(!endsWith(longer, tooLong));
+}
+
+BOOST_AUTO_TEST_CASE(findContentAliasesTest)
+{
+    //Setup: an equal content, a suffix, a content with the same tail that is no suffix, a left out and an empty one
+    const std::vector<std::string> contents = {"World", "Hello World", "Hello World", "", "", "Hello Xorld", "orld"};
+    std::vector<std::unique_ptr<ByteSource>> sources;
+    for (const std::string &content : contents)
+    {
+        sources.push_back(std::make_unique<StringSource>(content));
+    }
+    sources[3].reset();
+
+    //Testing: the first of the longest contents holds the content
+    const std::vector<ContentAlias> aliases = findContentAliases(sources);
+    BOOST_REQUIRE_EQUAL(aliases.size(), sources.size());
+    BOOST_CHECK_EQUAL(aliases[0].target, 1u);
+    BOOST_CHECK_EQUAL(aliases[0].offset, 6u);
+    BOOST_CHECK_EQUAL(aliases[1].target, 1u);
+    BOOST_CHECK_EQUAL(aliases[2].target, 1u);
+    BOOST_CHECK_EQUAL(aliases[2].offset, 0u);
+    BOOST_CHECK_EQUAL(aliases[3].target, 3u);
+    BOOST_CHECK_EQUAL(aliases[4].target, 4u);
+    BOOST_CHECK_EQUAL(aliases[5].target, 5u);
+    BOOST_CHECK_EQUAL(aliases[6].target, 1u);
+    BOOST_CHECK_EQUAL(aliases[6].offset, 7u);
+
+    //Testing: the sources are rewound
+    char first;
+    BOOST_CHECK_EQUAL(sources[1]->read(&first, 1), 1u);
+    BOOST_CHECK_EQUAL(first, 'H');
+}
+
+BOOST_AUTO_TEST_CASE(longContentTest)
+{
+    //Setup: contents longer than a chunk whose last bytes are equal but whose beginnings differ
+    const std::string tail(SOURCE_CHUNK_SIZE, 't');
+    const std::vector<std::string> contents = {"ab" + tail, "cb" + tail, "b" + tail};
+    std::vector<std::unique_ptr<ByteSource>> sources;
+    for (const std::string &content : contents)
+    {
+        sources.push_back(std::make_unique<StringSource>(content));
+    }
+
+    //Testing
+    const std::vector<ContentAlias> aliases = findContentAliases(sources);
+    BOOST_CHECK_EQUAL(aliases[0].target, 0u);
+    BOOST_CHECK_EQUAL(aliases[1].target, 1u);
+    BOOST_CHECK_EQUAL(aliases[2].target, 0u);
+    BOOST_CHECK_EQUAL(aliases[2].offset, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(manyContentsTest)
+{
+    //Setup: more distinct contents in one file than a process may have open files, with a long and a short end of
+    //one of them and a copy of another one behind them
+    const std::string path = "TESTContentDeduplicator_many.txt";
+    const std::size_t count = 20000;
+    std::vector<std::string> contents;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        contents.push_back("content number " + std::to_string(1000000 + i) + " with forty bytes..");
+    }
+    contents.push_back(contents[7].substr(2));
+    contents.push_back(contents[7].substr(contents[7].size() - 5));
+    contents.push_back(contents[9]);
+    std::vector<std::unique_ptr<ByteSource>> sources;
+    {
+        std::ofstream file(path, std::ios::binary);
+        std::streamoff offset = 0;
+        for (const std::string &content : contents)
+        {
+            file << content;
+            sources.push_back(std::make_unique<FileRangeSource>(path, offset, content.size()));
+            offset += static_cast<std::streamoff>(content.size());
+        }
+    }
+
+    //Testing
+    const std::vector<ContentAlias> aliases = findContentAliases(sources);
+    std::remove(path.c_str());
+
+    //Expected Output: the distinct contents hold their own content, the ends and the copy point into theirs, the
+    //short end is the end of every content and goes to the first one
+    std::size_t roots = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        roots += aliases[i].target == i ? 1 : 0;
+    }
+    BOOST_CHECK_EQUAL(roots, count);
+    BOOST_CHECK_EQUAL(aliases[count].target, 7u);
+    BOOST_CHECK_EQUAL(aliases[count].offset, 2u);
+    BOOST_CHECK_EQUAL(aliases[count + 1].target, 0u);
+    BOOST_CHECK_EQUAL(aliases[count + 1].offset, contents[7].size() - 5);
+    BOOST_CHECK_EQUAL(aliases[count + 2].target, 9u);
+    BOOST_CHECK_EQUAL(aliases[count + 2].offset, 0u);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,24 @@
+#define BOOST_TEST_MODULE DependencyFiletests
+#include <boost/test/unit_test.hpp>
+#include <DependencyFile.h>
+
+BOOST_AUTO_TEST_SUITE(DependencyFileTestSuite)
+
+BOOST_AUTO_TEST_CASE(escapeMakePathTest)
+{
+    BOOST_CHECK_EQUAL(escapeMakePath("out/text.h"), "out/text.h");
+    BOOST_CHECK_EQUAL(escapeMakePath("my dir/text.h"), "my\\ dir/text.h");
+    BOOST_CHECK_EQUAL(escapeMakePath("a#b$c"), "a\\#b$$c");
+}
+
+BOOST_AUTO_TEST_CASE(writeMakeRuleTest)
+{
+    //Testing: all generated files depend on all inputs
+    BOOST_CHECK_EQUAL(writeMakeRule({"out/text.h", "out/text.c"}, {"text.txt"}),
+                      "out/text.h \\\n  out/text.c: \\\n  text.txt\n");
+
+    //Testing: a rule without inputs is still complete
+    BOOST_CHECK_EQUAL(writeMakeRule({"out/text.h"}, {}), "out/text.h:\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,130 @@
+#define BOOST_TEST_MODULE ElfObjectWritertests
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <ElfObjectWriter.h>
+
+BOOST_AUTO_TEST_SUITE(ElfObjectWriterTestSuite)
+
+// Reads a little endian field of the object file
+std::uint64_t field(const std::string &object, const std::size_t offset, const std::size_t bytes)
+{
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < bytes; ++i)
+    {
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(object[offset + i])) << (8 * i);
+    }
+    return value;
+}
+
+// Offset of the header of a section
+std::size_t sectionHeader(const std::string &object, const std::size_t index)
+{
+    return field(object, 40, 8) + index * 64;
+}
+
+BOOST_AUTO_TEST_CASE(writeObjectTest)
+{
+    //Setup: two strings and an array behind the first one
+    const std::string text = "Hello\nWorld";
+    const std::string raw = "\x01\x02xyz";
+    const std::string other(2 * SOURCE_CHUNK_SIZE + 3, 'o');
+    ElfObjectWriter writer;
+    writer.addString("TEXT", std::make_unique<StringSource>(text));
+    writer.addArray("RAW", std::make_unique<StringSource>(raw));
+    writer.addString("OTHER", std::make_unique<StringSource>(other));
+    writer.addStringArray("LAST", std::make_unique<StringSource>(text));
+
+    //Testing
+    std::string object;
+    StringSink sink(object);
+    const std::size_t size = writer.write(sink);
+    BOOST_CHECK_EQUAL(size, object.size());
+
+    //Expected Output: a relocatable ELF64 file, the section headers are the last part of it
+    BOOST_REQUIRE(object.compare(0, 4, "\x7f" "ELF") == 0);
+    BOOST_CHECK_EQUAL(object[4], 2);
+    BOOST_CHECK_EQUAL(field(object, 16, 2), 1u);
+    const std::size_t sectionCount = field(object, 60, 2);
+    BOOST_CHECK_EQUAL(sectionHeader(object, sectionCount), object.size());
+
+    // the names of the sections and symbols
+    const std::size_t shstrtab = field(object, sectionHeader(object, field(object, 62, 2)) + 24, 8);
+    std::map<std::string, std::size_t> sections;
+    for (std::size_t i = 1; i < sectionCount; ++i)
+    {
+        sections[object.c_str() + shstrtab + field(object, sectionHeader(object, i), 4)] = i;
+    }
+    BOOST_REQUIRE(sections.count(".rodata") == 1 && sections.count(".symtab") == 1 && sections.count(".rela.data.rel.ro") == 1);
+
+    const std::size_t rodata = field(object, sectionHeader(object, sections[".rodata"]) + 24, 8);
+    BOOST_CHECK_EQUAL(object.compare(rodata, text.size() + 1, text.c_str(), text.size() + 1), 0);
+    BOOST_CHECK_EQUAL(object.compare(rodata + text.size() + 1, raw.size(), raw), 0);
+    BOOST_CHECK_EQUAL(object.compare(rodata + text.size() + 1 + raw.size(), other.size(), other), 0);
+    const std::size_t last = text.size() + 1 + raw.size() + other.size() + 1;
+    BOOST_CHECK_EQUAL(object.compare(rodata + last, text.size() + 1, text.c_str(), text.size() + 1), 0);
+
+    const std::size_t symtabHeader = sectionHeader(object, sections[".symtab"]);
+    const std::size_t symtab = field(object, symtabHeader + 24, 8);
+    const std::size_t symbolCount = field(object, symtabHeader + 32, 8) / 24;
+    const std::size_t strtab = field(object, sectionHeader(object, field(object, symtabHeader + 40, 4)) + 24, 8);
+    std::map<std::string, std::size_t> symbols;
+    for (std::size_t i = field(object, symtabHeader + 44, 4); i < symbolCount; ++i)
+    {
+        symbols[object.c_str() + strtab + field(object, symtab + i * 24, 4)] = i;
+    }
+    BOOST_REQUIRE_EQUAL(symbols.size(), 4u);
+
+    // the array is a symbol in .rodata with the size of its content
+    const std::size_t rawSymbol = symtab + symbols["RAW"] * 24;
+    BOOST_CHECK_EQUAL(field(object, rawSymbol + 6, 2), sections[".rodata"]);
+    BOOST_CHECK_EQUAL(field(object, rawSymbol + 8, 8), text.size() + 1);
+    BOOST_CHECK_EQUAL(field(object, rawSymbol + 16, 8), raw.size());
+
+    // a string array is the NUL terminated text itself, it needs no relocation
+    const std::size_t lastSymbol = symtab + symbols["LAST"] * 24;
+    BOOST_CHECK_EQUAL(field(object, lastSymbol + 6, 2), sections[".rodata"]);
+    BOOST_CHECK_EQUAL(field(object, lastSymbol + 8, 8), last);
+    BOOST_CHECK_EQUAL(field(object, lastSymbol + 16, 8), text.size() + 1);
+    BOOST_CHECK_EQUAL(field(object, sectionHeader(object, sections[".rela.data.rel.ro"]) + 32, 8), 2u * 24u);
+
+    // the strings are pointers relocated to their text
+    const std::size_t rela = field(object, sectionHeader(object, sections[".rela.data.rel.ro"]) + 24, 8);
+    const std::size_t otherSymbol = symtab + symbols["OTHER"] * 24;
+    BOOST_CHECK_EQUAL(field(object, otherSymbol + 16, 8), 8u);
+    BOOST_CHECK_EQUAL(field(object, rela + 24, 8), field(object, otherSymbol + 8, 8));
+    BOOST_CHECK_EQUAL(field(object, rela + 24 + 16, 8), text.size() + 1 + raw.size());
+}
+BOOST_AUTO_TEST_CASE(fileRangesTest)
+{
+    //Setup: more file ranges than a process may have open files, added before the file exists
+    const std::string path = "TESTElfObjectWriter_ranges.txt";
+    const std::size_t count = 5000;
+    std::remove(path.c_str());
+    ElfObjectWriter writer;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        writer.addArray("RANGE" + std::to_string(i), std::make_unique<FileRangeSource>(path, static_cast<std::streamoff>(i % 10), 1));
+    }
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "0123456789";
+    }
+
+    //Testing
+    std::string object;
+    StringSink sink(object);
+    writer.write(sink);
+    std::remove(path.c_str());
+
+    //Expected Output: every range is opened while it is copied, the bytes follow each other in .rodata
+    std::string expected;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        expected += static_cast<char>('0' + i % 10);
+    }
+    BOOST_CHECK(object.find(expected) != std::string::npos);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,7 @@
 #define BOOST_TEST_MODULE ExtractorTests
 #include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <cstdio>
 #include <Extractor.h>
 
 BOOST_AUTO_TEST_SUITE(ExtractorTestSuite)
@@ -24,11 +26,47 @@ BOOST_AUTO_TEST_SUITE(ExtractorTestSuite)
         std::map<std::string, std::string> result = parseJsonString(givenstring);
         BOOST_CHECK(expected == result);
     }
-/*
+
     BOOST_AUTO_TEST_CASE(extractOptionsAndVariablesTest)
     {
+        //Given Input
+        const std::string fileName = "TESTExtractorInput.txt";
+        {
+            std::ofstream file(fileName, std::ios::trunc);
+            file << "Text before\n@start\n@global { \"signperline\": 60 }\n"
+                    "@variable { \"varname\": \"FIRST\", \"seq\": \"ESC\" }\nLine one\nLine two\n@endvariable\n"
+                    "@variable { \"varname\": \"SECOND\", \"seq\": \"HEX\" }\n\n@endvariable\n@end\n";
+        }
+        //Expected Output
+        const std::string expectedContent = "Line one\nLine two\n";
+
+        //Using function
+        std::map<std::string, std::string> options;
+        std::vector<std::map<std::string, std::string>> variables;
+        extractOptionsAndVariables(fileName, options, variables);
 
-        extractOptionsAndVariables();
+        std::map<std::string, std::string> streamOptions;
+        std::vector<std::map<std::string, std::string>> streamVariables;
+        extractOptionsAndVariables(fileName, streamOptions, streamVariables, false);
+
+        BOOST_CHECK(options.at("signperline") == "60");
+        BOOST_REQUIRE(variables.size() == 2 && streamVariables.size() == 2);
+        BOOST_CHECK(variables[0].at("content") == expectedContent);
+        BOOST_CHECK(variables[0].at("VariableLineNumber") == "4");
+        BOOST_CHECK(streamVariables[0].at("content").empty());
+
+        //The range in the file is the content
+        std::ifstream file(fileName);
+        file.seekg(std::stoll(streamVariables[0].at("ContentOffset")));
+        std::string content(std::stoull(streamVariables[0].at("ContentLength")), '\0');
+        file.read(&content[0], content.size());
+        BOOST_CHECK(content == expectedContent);
+        BOOST_CHECK(streamVariables[0].at("ContentTail") == "o\n");
+        BOOST_CHECK(streamVariables[1].at("ContentLength") == "1");
+        BOOST_CHECK(streamVariables[1].at("ContentTail") == "\n");
+        file.close();
+
+        std::remove(fileName.c_str());
     }
-*/
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,62 @@
+#define BOOST_TEST_MODULE IncbinWritertests
+#include <boost/test/unit_test.hpp>
+#include <IncbinWriter.h>
+
+BOOST_AUTO_TEST_SUITE(IncbinWriterTestSuite)
+
+BOOST_AUTO_TEST_CASE(writeStringTest)
+{
+    //Setup
+    IncbinWriter writer;
+    writer.addString("TEXT", "/out/dir\\name_TEXT.bin", 11);
+
+    //Testing
+    std::string output;
+    StringSink sink(output);
+    writer.write(sink);
+
+    //Expected Output: a pointer to the NUL terminated text and the size, the backslash of the path is escaped
+    const std::string expected = "\t.section .rodata\n"
+                                 ".LTEXT_data:\n"
+                                 "\t.incbin \"/out/dir\\\\name_TEXT.bin\"\n"
+                                 "\t.byte 0\n"
+                                 "\t.section .data.rel.ro, \"aw\"\n"
+                                 "\t.balign 8\n"
+                                 "\t.global TEXT\n"
+                                 "\t.type TEXT, %object\n"
+                                 "TEXT:\n"
+                                 "\t.dc.a .LTEXT_data\n"
+                                 "\t.size TEXT, . - TEXT\n"
+                                 "\t.section .rodata\n"
+                                 "\t.balign 8\n"
+                                 "\t.global TEXT_size\n"
+                                 "\t.type TEXT_size, %object\n"
+                                 "TEXT_size:\n"
+                                 "\t.dc.a 11\n"
+                                 "\t.size TEXT_size, . - TEXT_size\n";
+    BOOST_CHECK(output.find(expected) != std::string::npos);
+    BOOST_CHECK(output.find(".note.GNU-stack") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(writeArrayTest)
+{
+    //Setup
+    IncbinWriter writer;
+    writer.addArray("RAW", "raw.bin", 3);
+
+    //Testing
+    std::string output;
+    StringSink sink(output);
+    writer.write(sink);
+
+    //Expected Output: the array is the symbol of the included bytes
+    const std::string expected = "\t.global RAW\n"
+                                 "\t.type RAW, %object\n"
+                                 "RAW:\n"
+                                 "\t.incbin \"raw.bin\"\n"
+                                 "\t.size RAW, . - RAW\n";
+    BOOST_CHECK(output.find(expected) != std::string::npos);
+    BOOST_CHECK(output.find(".byte 0") == std::string::npos);
+    BOOST_CHECK_EQUAL(IncbinWriter::sizeDeclaration("RAW"), "extern const size_t RAW_size;\n");
+}
+BOOST_AUTO_TEST_SUITE_END()
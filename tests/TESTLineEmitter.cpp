@@ -0,0 +1,93 @@
+#define BOOST_TEST_MODULE LineEmittertests
+#include <boost/test/unit_test.hpp>
+#include <LineEmitter.h>
+
+BOOST_AUTO_TEST_SUITE(LineEmitterTestSuite)
+
+// Writes the four units with the emitter for the given new line mode
+template <NewLineMode Mode>
+std::string emitUnits(const std::string (&units)[4], const unsigned char (&sources)[4])
+{
+    std::string output;
+    StringSink sink(output);
+    LineEmitter<Mode> emitter(sink, 60, "\"");
+    for (int i = 0; i < 4; ++i)
+    {
+        emitter.unit(units[i].data(), units[i].size(), sources[i]);
+    }
+    emitter.finish();
+    return output;
+}
+
+BOOST_AUTO_TEST_CASE(wrapFixedUnitsTest)
+{
+    //Setup
+    std::string output;
+    StringSink sink(output);
+    LineEmitter<NewLineMode::UNIX> emitter(sink, 8, "\"");
+
+    //Testing
+    for (int i = 0; i < 5; ++i)
+    {
+        emitter.unit("\\x41", 4, 'A');
+    }
+    emitter.finish();
+
+    //Expected Output
+    const std::string expected = "\"\\x41\\x41\" \\\n"
+                                 "\"\\x41\\x41\" \\\n"
+                                 "\"\\x41\" \\\n";
+    BOOST_CHECK(output == expected);
+}
+
+BOOST_AUTO_TEST_CASE(newLineModesTest)
+{
+    //Given Input: a CR LF sequence in the middle of the text
+    const std::string units[] = {"a", "\\r", "\\n", "b"};
+    const unsigned char sources[] = {'a', '\r', '\n', 'b'};
+
+    //Expected Output
+    const std::string expectedUnix = "\"a\\r\\n\" \\\n\"b\" \\\n";
+    const std::string expectedDos = "\"a\\r\\n\" \\\n\"b\" \\\n";
+    const std::string expectedMac = "\"a\\r\" \\\n\"\\nb\" \\\n";
+
+    //Testing
+    BOOST_CHECK(emitUnits<NewLineMode::UNIX>(units, sources) == expectedUnix);
+    BOOST_CHECK(emitUnits<NewLineMode::DOS>(units, sources) == expectedDos);
+    BOOST_CHECK(emitUnits<NewLineMode::MAC>(units, sources) == expectedMac);
+}
+
+BOOST_AUTO_TEST_CASE(longWordTest)
+{
+    //Setup
+    std::string output;
+    StringSink sink(output);
+    LineEmitter<NewLineMode::UNIX> emitter(sink, 6, "");
+
+    //Testing: a word that is longer than a line is not split and gets no empty line in front
+    emitter.unit("ab ", 3, 0);
+    emitter.append("cdefgh", 6);
+    emitter.append("ijkl ", 5);
+    emitter.endUnit();
+    emitter.unit("m", 1, 0);
+    emitter.finish();
+
+    //Expected Output
+    const std::string expected = "ab  \\\n"
+                                 "cdefghijkl  \\\n"
+                                 "m \\\n";
+    BOOST_CHECK(output == expected);
+}
+
+BOOST_AUTO_TEST_CASE(emptyTest)
+{
+    //Setup
+    std::string output;
+    StringSink sink(output);
+    LineEmitter<NewLineMode::DOS> emitter(sink, 60, "\"");
+
+    //Testing
+    emitter.finish();
+    BOOST_CHECK(output.empty());
+}
+BOOST_AUTO_TEST_SUITE_END()
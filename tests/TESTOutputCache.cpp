@@ -0,0 +1,169 @@
+#define BOOST_TEST_MODULE OutputCachetests
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <sstream>
+#include <OutputCache.h>
+
+namespace
+{
+    std::string readFile(const std::filesystem::path &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    void writeFile(const std::filesystem::path &path, const std::string &content)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+
+    CacheKey keyOf(const std::string &text)
+    {
+        CacheKey key;
+        key.addText(text);
+        return key;
+    }
+
+    // the entry of a key is the directory KEY[0..1]/KEY[2..]
+    std::filesystem::path manifestPath(const std::filesystem::path &cacheDirectory, const CacheKey &key)
+    {
+        const std::string name = key.toString();
+        return cacheDirectory / name.substr(0, 2) / name.substr(2) / "manifest";
+    }
+
+    // a build tree with a header and a source directory
+    struct BuildTree
+    {
+        std::filesystem::path headerDirectory;
+        std::filesystem::path sourceDirectory;
+
+        explicit BuildTree(const std::filesystem::path &root)
+            : headerDirectory(root / "include"), sourceDirectory(root / "src")
+        {
+            std::filesystem::remove_all(root);
+            std::filesystem::create_directories(headerDirectory);
+            std::filesystem::create_directories(sourceDirectory);
+        }
+    };
+}
+
+BOOST_AUTO_TEST_SUITE(OutputCacheTestSuite)
+
+BOOST_AUTO_TEST_CASE(keyTest)
+{
+    //Testing: the 128 bit FNV-1a hash of the reference values
+    BOOST_CHECK_EQUAL(CacheKey().toString(), "6c62272e07bb014262b821756295c58d");
+    CacheKey key;
+    key.add("a", 1);
+    BOOST_CHECK_EQUAL(key.toString(), "d228cb696f1a8caf78912b704e4a8964");
+
+    //Testing: the length is part of the key, so the strings can not run into each other
+    CacheKey first;
+    first.addText("ab");
+    first.addText("c");
+    CacheKey second;
+    second.addText("a");
+    second.addText("bc");
+    BOOST_CHECK_NE(first.toString(), second.toString());
+}
+
+BOOST_AUTO_TEST_CASE(restoreTest)
+{
+    //Setup
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "TESTOutputCache";
+    std::filesystem::remove_all(root);
+    const BuildTree first(root / "first");
+    const BuildTree second(root / "second");
+    OutputCache cache(root / "cache", 1024 * 1024);
+
+    std::vector<std::filesystem::path> restored;
+    std::size_t unchangedFiles = 0;
+    BOOST_CHECK(!cache.restore(keyOf("42"), first.headerDirectory, first.sourceDirectory, restored, unchangedFiles));
+
+    writeFile(first.headerDirectory / "text.h", "header");
+    writeFile(first.sourceDirectory / "text.c", "source");
+    writeFile(first.sourceDirectory / "NAME.bin", "binary");
+    cache.store(keyOf("42"), first.headerDirectory / "text.h", {first.sourceDirectory / "text.c", first.sourceDirectory / "NAME.bin"});
+
+    //Testing: another build tree gets the same files
+    BOOST_CHECK(cache.restore(keyOf("42"), second.headerDirectory, second.sourceDirectory, restored, unchangedFiles));
+    BOOST_CHECK_EQUAL(restored.size(), 3);
+    BOOST_CHECK_EQUAL(unchangedFiles, 0);
+    BOOST_CHECK_EQUAL(readFile(second.headerDirectory / "text.h"), "header");
+    BOOST_CHECK_EQUAL(readFile(second.sourceDirectory / "text.c"), "source");
+    BOOST_CHECK_EQUAL(readFile(second.sourceDirectory / "NAME.bin"), "binary");
+
+    //Testing: files that already have the content are not written again
+    BOOST_CHECK(cache.restore(keyOf("42"), first.headerDirectory, first.sourceDirectory, restored, unchangedFiles));
+    BOOST_CHECK_EQUAL(unchangedFiles, 3);
+    BOOST_CHECK(!cache.restore(keyOf("43"), first.headerDirectory, first.sourceDirectory, restored, unchangedFiles));
+
+    //Testing: the counters are added to the statistics file
+    cache.finish();
+    BOOST_CHECK_EQUAL(readFile(root / "cache" / "stats"), "evicted 0\nhits 2\nmisses 2\nstored 1\n");
+
+    std::filesystem::remove_all(root);
+}
+
+BOOST_AUTO_TEST_CASE(otherKeyTest)
+{
+    //Setup
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "TESTOutputCacheOtherKey";
+    std::filesystem::remove_all(root);
+    const BuildTree tree(root / "tree");
+    writeFile(tree.headerDirectory / "text.h", "header");
+    OutputCache cache(root / "cache", 1024 * 1024);
+    cache.store(keyOf("1"), tree.headerDirectory / "text.h", {});
+
+    //Testing: an entry whose manifest names another key is not restored, nothing is copied
+    const std::filesystem::path manifest = manifestPath(root / "cache", keyOf("1"));
+    std::string content = readFile(manifest);
+    content.replace(content.find(keyOf("1").toString()), 32, keyOf("2").toString());
+    writeFile(manifest, content);
+
+    const BuildTree other(root / "other");
+    std::vector<std::filesystem::path> restored;
+    std::size_t unchangedFiles = 0;
+    BOOST_CHECK(!cache.restore(keyOf("1"), other.headerDirectory, other.sourceDirectory, restored, unchangedFiles));
+    BOOST_CHECK(restored.empty());
+    BOOST_CHECK(!std::filesystem::exists(other.headerDirectory / "text.h"));
+
+    std::filesystem::remove_all(root);
+}
+
+BOOST_AUTO_TEST_CASE(evictionTest)
+{
+    //Setup
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "TESTOutputCacheEviction";
+    std::filesystem::remove_all(root);
+    const BuildTree tree(root / "tree");
+    const std::string content(1000, 'x');
+    writeFile(tree.headerDirectory / "text.h", content);
+    writeFile(tree.sourceDirectory / "text.c", content);
+
+    //Testing: the entry used last stays when the cache is too big
+    OutputCache cache(root / "cache", 5000);
+    cache.store(keyOf("1"), tree.headerDirectory / "text.h", {tree.sourceDirectory / "text.c"});
+    cache.store(keyOf("2"), tree.headerDirectory / "text.h", {tree.sourceDirectory / "text.c"});
+    cache.store(keyOf("3"), tree.headerDirectory / "text.h", {tree.sourceDirectory / "text.c"});
+
+    std::vector<std::filesystem::path> restored;
+    std::size_t unchangedFiles = 0;
+    std::filesystem::last_write_time(manifestPath(root / "cache", keyOf("1")),
+                                     std::filesystem::file_time_type::clock::now() - std::chrono::hours(2));
+    std::filesystem::last_write_time(manifestPath(root / "cache", keyOf("2")),
+                                     std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+    BOOST_CHECK(cache.restore(keyOf("1"), tree.headerDirectory, tree.sourceDirectory, restored, unchangedFiles));
+    cache.finish();
+
+    BOOST_CHECK(cache.restore(keyOf("1"), tree.headerDirectory, tree.sourceDirectory, restored, unchangedFiles));
+    BOOST_CHECK(!cache.restore(keyOf("2"), tree.headerDirectory, tree.sourceDirectory, restored, unchangedFiles));
+    BOOST_CHECK(cache.restore(keyOf("3"), tree.headerDirectory, tree.sourceDirectory, restored, unchangedFiles));
+
+    std::filesystem::remove_all(root);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,66 @@
+#define BOOST_TEST_MODULE OutputFiletests
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <OutputFile.h>
+
+namespace
+{
+    std::string readFile(const std::filesystem::path &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    bool writeFile(const std::filesystem::path &path, const std::string &content)
+    {
+        OutputFile file(path, true);
+        file.stream() << content;
+        return file.commit();
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(OutputFileTestSuite)
+
+BOOST_AUTO_TEST_CASE(commitTest)
+{
+    //Setup
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "TESTOutputFile.txt";
+    std::filesystem::remove(path);
+
+    //Testing: a new file is written, the same content keeps the old file and its timestamp
+    BOOST_CHECK(writeFile(path, "first"));
+    const std::filesystem::file_time_type written = std::filesystem::last_write_time(path);
+    std::filesystem::last_write_time(path, written - std::chrono::hours(1));
+    BOOST_CHECK(!writeFile(path, "first"));
+    BOOST_CHECK(std::filesystem::last_write_time(path) == written - std::chrono::hours(1));
+
+    //Testing: a content of the same size or of another size replaces it
+    BOOST_CHECK(writeFile(path, "other"));
+    BOOST_CHECK_EQUAL(readFile(path), "other");
+    BOOST_CHECK(writeFile(path, "longer content"));
+    BOOST_CHECK_EQUAL(readFile(path), "longer content");
+    BOOST_CHECK(!std::filesystem::exists(path.string() + ".tmp"));
+
+    std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(withoutCommitTest)
+{
+    //Setup
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "TESTOutputFileAborted.txt";
+    std::filesystem::remove(path);
+    BOOST_CHECK(writeFile(path, "kept"));
+
+    //Testing: a file that is not committed, for example after an exception, leaves the old file
+    {
+        OutputFile file(path);
+        file.stream() << "lost";
+    }
+    BOOST_CHECK_EQUAL(readFile(path), "kept");
+    BOOST_CHECK(!std::filesystem::exists(path.string() + ".tmp"));
+
+    std::filesystem::remove(path);
+}
+BOOST_AUTO_TEST_SUITE_END()
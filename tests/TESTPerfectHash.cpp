@@ -0,0 +1,58 @@
+#define BOOST_TEST_MODULE PerfectHashtests
+#include <boost/test/unit_test.hpp>
+#include <set>
+#include <stdexcept>
+#include <PerfectHash.h>
+
+BOOST_AUTO_TEST_SUITE(PerfectHashTestSuite)
+
+BOOST_AUTO_TEST_CASE(hashNameTest)
+{
+    //Testing: the seed changes the hash, the values are the ones the generated function computes
+    BOOST_CHECK_NE(hashName("NAME", 0), hashName("NAME", 1));
+    BOOST_CHECK_NE(hashName("NAME", 0), hashName("NAMF", 0));
+    BOOST_CHECK_EQUAL(hashName("NAME", 0), 1961146020u);
+    BOOST_CHECK_EQUAL(hashName("NAME", 5), 513378390u);
+}
+
+BOOST_AUTO_TEST_CASE(buildPerfectHashTest)
+{
+    //Setup: names that differ in one character only and many names
+    for (const std::size_t count : {1, 2, 7, 64, 5000})
+    {
+        std::vector<std::string> names;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            names.push_back("VAR_" + std::to_string(i));
+        }
+
+        //Testing: every name finds itself in a slot of its own
+        const PerfectHash hash = buildPerfectHash(names);
+        BOOST_CHECK_GE(hash.slots.size(), count);
+        std::set<std::size_t> slots;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const std::size_t slot = findSlot(hash, names[i]);
+            BOOST_CHECK_EQUAL(hash.slots[slot], i);
+            slots.insert(slot);
+        }
+        BOOST_CHECK_EQUAL(slots.size(), count);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(duplicateNameTest)
+{
+    //Setup: a name given twice can never get two slots
+    const std::vector<std::string> names = {"FIRST", "SECOND", "FIRST"};
+
+    //Testing: the search gives up instead of doubling the table forever
+    BOOST_CHECK_THROW(buildPerfectHash(names), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(writeHashFunctionTest)
+{
+    //Testing
+    const std::string function = writeHashFunction("FILE_hash");
+    BOOST_CHECK_EQUAL(function.rfind("static inline uint32_t FILE_hash(const char *name, size_t length, uint32_t seed)\n", 0), 0u);
+}
+BOOST_AUTO_TEST_SUITE_END()
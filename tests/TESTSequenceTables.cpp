@@ -0,0 +1,43 @@
+#define BOOST_TEST_MODULE SequenceTablestests
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <iomanip>
+#include <SequenceTables.h>
+
+BOOST_AUTO_TEST_SUITE(SequenceTablesTestSuite)
+
+BOOST_AUTO_TEST_CASE(tablesAtCompileTimeTest)
+{
+    static_assert(HEX_TABLE['A'][2] == '4' && HEX_TABLE['A'][3] == '1', "HEX table is built at compile time");
+    static_assert(OCT_TABLE['\n'][1] == '0' && OCT_TABLE['\n'][3] == '2', "OCT table is built at compile time");
+    static_assert(RAWHEX_TABLE[0xff][2] == 'f', "RAWHEX table is built at compile time");
+    BOOST_CHECK(std::string(HEX_TABLE['\n'].data(), 4) == "\\x0a");
+}
+
+BOOST_AUTO_TEST_CASE(tablesMatchStreamFormattingTest)
+{
+    //Expected Output is what the std::stringstream formatting produced for every byte
+    for (int c = 0; c < 256; ++c)
+    {
+        std::stringstream hex;
+        hex << "\\x" << std::hex << std::setfill('0') << std::setw(2) << c;
+        std::stringstream oct;
+        oct << "\\" << std::oct << std::setfill('0') << std::setw(3) << c;
+        std::stringstream rawHex;
+        rawHex << "0x" << std::hex << std::setfill('0') << std::setw(2) << c << ", ";
+
+        BOOST_CHECK(std::string(HEX_TABLE[c].data(), HEX_FRAGMENT_WIDTH) == hex.str());
+        BOOST_CHECK(std::string(OCT_TABLE[c].data(), OCT_FRAGMENT_WIDTH) == oct.str());
+        BOOST_CHECK(std::string(RAWHEX_TABLE[c].data(), RAWHEX_FRAGMENT_WIDTH) == rawHex.str());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(writeFragmentTest)
+{
+    //Testing
+    char buffer[8] = {};
+    char *end = writeFragment(buffer, RAWHEX_TABLE, 'a');
+    BOOST_CHECK(end == buffer + RAWHEX_FRAGMENT_WIDTH);
+    BOOST_CHECK(std::string(buffer) == "0x61, ");
+}
+BOOST_AUTO_TEST_SUITE_END()
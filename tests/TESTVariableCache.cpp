@@ -0,0 +1,127 @@
+#define BOOST_TEST_MODULE VariableCachetests
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <VariableCache.h>
+
+namespace
+{
+    std::string readFile(const std::filesystem::path &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // writes the parts as source and indexes each under its position in the list
+    void writeSource(const std::filesystem::path &path, const std::vector<std::string> &parts)
+    {
+        VariableCache cache(path);
+        OutputFile sourceFile(path, true);
+        for (std::size_t i = 0; i < parts.size(); i++)
+        {
+            cache.record(i + 1, static_cast<std::size_t>(sourceFile.stream().tellp()), parts[i].size());
+            sourceFile.stream() << parts[i];
+        }
+        cache.commit(sourceFile);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(VariableCacheTestSuite)
+
+BOOST_AUTO_TEST_CASE(hashTest)
+{
+    //Testing: the length is part of the hash, so the strings of a key can not run into each other
+    BOOST_CHECK_NE(hashText(hashText(CACHE_HASH_BASIS, "ab"), "c"), hashText(hashText(CACHE_HASH_BASIS, "a"), "bc"));
+    BOOST_CHECK_EQUAL(hashText(CACHE_HASH_BASIS, "abc"), hashText(CACHE_HASH_BASIS, "abc"));
+
+    //Testing: a source hashes like its size and bytes
+    const std::string content = "some content";
+    StringSource source(content);
+    const std::uint64_t expected = hashBytes(hashText(CACHE_HASH_BASIS, std::to_string(content.size())), content.data(), content.size());
+    BOOST_CHECK_EQUAL(hashSource(CACHE_HASH_BASIS, source), expected);
+}
+
+BOOST_AUTO_TEST_CASE(copyTest)
+{
+    //Setup
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "TESTVariableCache.c";
+    std::filesystem::remove(path);
+    std::filesystem::remove(path.string() + ".cache");
+
+    //Testing: without a previous source nothing is cached
+    BOOST_CHECK(!VariableCache(path).contains(1));
+
+    //Testing: the code of the previous source is found by its key
+    writeSource(path, {"first\n", "second\n"});
+    VariableCache cache(path);
+    BOOST_CHECK(cache.contains(1));
+    BOOST_CHECK(cache.contains(2));
+    BOOST_CHECK(!cache.contains(3));
+
+    std::string copied;
+    StringSink sink(copied);
+    BOOST_CHECK_EQUAL(cache.copy(2, sink), 7);
+    BOOST_CHECK_EQUAL(cache.copy(1, sink), 6);
+    BOOST_CHECK_EQUAL(copied, "second\nfirst\n");
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(path.string() + ".cache");
+}
+
+BOOST_AUTO_TEST_CASE(cacheHitTest)
+{
+    //Setup: a previous source with new lines of every mode
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "TESTVariableCacheHit.c";
+    const std::vector<std::string> parts = {"first\r\n", "second\n\r", "third\n"};
+    writeSource(path, parts);
+    const std::string expected = readFile(path);
+
+    //Testing: the next run copies every part and writes the same source, which fits its new index again
+    for (int run = 0; run < 2; run++)
+    {
+        VariableCache cache(path);
+        OutputFile sourceFile(path, true);
+        StreamSink sink(sourceFile.stream());
+        for (std::uint64_t key = 1; key <= parts.size(); key++)
+        {
+            BOOST_REQUIRE(cache.contains(key));
+            const std::size_t offset = static_cast<std::size_t>(sourceFile.stream().tellp());
+            cache.record(key, offset, cache.copy(key, sink));
+        }
+        cache.commit(sourceFile);
+        BOOST_CHECK_EQUAL(readFile(path), expected);
+    }
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(path.string() + ".cache");
+}
+
+BOOST_AUTO_TEST_CASE(changedSourceTest)
+{
+    //Setup
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "TESTVariableCache.cpp";
+    writeSource(path, {"first\n"});
+    BOOST_CHECK(VariableCache(path).contains(1));
+
+    //Testing: a source that was changed by someone else does not fit the index any more
+    {
+        std::ofstream source(path, std::ios::app);
+        source << "edited\n";
+    }
+    BOOST_CHECK(!VariableCache(path).contains(1));
+
+    //Testing: a damaged index is ignored
+    writeSource(path, {"first\n"});
+    {
+        std::ofstream index(path.string() + ".cache", std::ios::app);
+        index << "damaged\n";
+    }
+    BOOST_CHECK(!VariableCache(path).contains(1));
+    BOOST_CHECK_EQUAL(readFile(path), "first\n");
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(path.string() + ".cache");
+}
+
+BOOST_AUTO_TEST_SUITE_END()